@@ -874,7 +874,14 @@ int inv_icm426xx_get_data_from_registers(struct inv_icm426xx * s)
 	return status;
 }
 
+#if ICM426XX_FIFO_MIRRORING_SIZE > 0
 int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
+{
+	return inv_icm426xx_get_data_from_fifo_buf(s, s->fifo_data, ICM426XX_FIFO_MIRRORING_SIZE);
+}
+#endif
+
+int inv_icm426xx_get_data_from_fifo_buf(struct inv_icm426xx * s, uint8_t * buf, uint16_t len)
 {
 	int status = 0; 
 	uint8_t int_status;
@@ -905,6 +912,10 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 			if(s->fifo_highres_enabled)
 				packet_size = FIFO_20BYTES_PACKET_SIZE;
 
+			/* Packets that don't fit in the buffer are left in the FIFO */
+			if(packet_count > len / packet_size)
+				packet_count = len / packet_size;
+
 			if(s->transport.serif.serif_type == ICM426XX_UI_I3C) {
 				/* in case of I3C, need to read packet by packet since INT is embedded on protocol so this can 
 				happen that FIFO read is interrupted to handle IBI, and in that case FIFO is partially read.
@@ -914,7 +925,7 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 				2nd solution prefered here because less heavy from driver point of view but it is less optimal
 				for the timing because we have to initiate N transactions in any case */
 				for(packet_count_i = 0 ; packet_count_i < packet_count ; packet_count_i++) {
-					status |= inv_icm426xx_read_reg(s, MPUREG_FIFO_DATA, packet_size, &s->fifo_data[packet_count_i*packet_size]);
+					status |= inv_icm426xx_read_reg(s, MPUREG_FIFO_DATA, packet_size, &buf[packet_count_i*packet_size]);
 					if(status) {
 						/* sensor data is in FIFO according to FIFO_COUNT but failed to read FIFO,
 							  reset FIFO and try next chance */
@@ -923,12 +934,20 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 					}
 				}
 			} else {
-				status |= inv_icm426xx_read_reg(s, MPUREG_FIFO_DATA, packet_size * packet_count, s->fifo_data);
-				if(status) {
-					/* sensor data is in FIFO according to FIFO_COUNT but failed to read FIFO,
-						  reset FIFO and try next chance */
-					inv_icm426xx_reset_fifo(s);
-					return status;
+				/* Read as many packets per transaction as the serial interface allows */
+				uint16_t chunk = s->transport.serif.max_read / packet_size;
+				if(chunk == 0)
+					return INV_ERROR_SIZE;
+				for(packet_count_i = 0 ; packet_count_i < packet_count ; packet_count_i += chunk) {
+					if(chunk > packet_count - packet_count_i)
+						chunk = packet_count - packet_count_i;
+					status |= inv_icm426xx_read_reg(s, MPUREG_FIFO_DATA, packet_size * chunk, &buf[packet_count_i*packet_size]);
+					if(status) {
+						/* sensor data is in FIFO according to FIFO_COUNT but failed to read FIFO,
+							  reset FIFO and try next chance */
+						inv_icm426xx_reset_fifo(s);
+						return status;
+					}
 				}
 			}
 			
@@ -936,7 +955,7 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 				inv_icm426xx_sensor_event_t event;
 				event.sensor_mask = 0;
 				
-				header = (fifo_header_t *) &s->fifo_data[fifo_idx];
+				header = (fifo_header_t *) &buf[fifo_idx];
 				fifo_idx += FIFO_HEADER_SIZE;
 				
 				/* Decode packet */
@@ -947,29 +966,29 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 				}
 
 				if(header->bits.accel_bit) {
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[0+fifo_idx], (uint16_t *)&event.accel[0]);
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[2+fifo_idx], (uint16_t *)&event.accel[1]);
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[4+fifo_idx], (uint16_t *)&event.accel[2]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[0+fifo_idx], (uint16_t *)&event.accel[0]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[2+fifo_idx], (uint16_t *)&event.accel[1]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[4+fifo_idx], (uint16_t *)&event.accel[2]);
 					fifo_idx += FIFO_ACCEL_DATA_SIZE;
 				}
 
 				if (header->bits.gyro_bit) {
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[0+fifo_idx], (uint16_t *)&event.gyro[0]);
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[2+fifo_idx], (uint16_t *)&event.gyro[1]);
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[4+fifo_idx], (uint16_t *)&event.gyro[2]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[0+fifo_idx], (uint16_t *)&event.gyro[0]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[2+fifo_idx], (uint16_t *)&event.gyro[1]);
+					inv_icm426xx_format_data(s->endianess_data, &buf[4+fifo_idx], (uint16_t *)&event.gyro[2]);
 					fifo_idx += FIFO_GYRO_DATA_SIZE;
 				}
 
 				if ((header->bits.accel_bit) || (header->bits.gyro_bit)) {
 					if(header->bits.twentybits_bit) {
-						inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[0+fifo_idx], (uint16_t *)&event.temperature);
+						inv_icm426xx_format_data(s->endianess_data, &buf[0+fifo_idx], (uint16_t *)&event.temperature);
 						fifo_idx += FIFO_TEMP_DATA_SIZE + FIFO_TEMP_HIGH_RES_SIZE;
 
 						/* new temperature data */
 						if (event.temperature != INVALID_VALUE_FIFO)
 							event.sensor_mask |= (1 << INV_ICM426XX_SENSOR_TEMPERATURE);
 					} else {
-						event.temperature = (int8_t)s->fifo_data[0+fifo_idx]; /* cast to int8_t since FIFO is in 16 bits mode (temperature on 8 bits) */
+						event.temperature = (int8_t)buf[0+fifo_idx]; /* cast to int8_t since FIFO is in 16 bits mode (temperature on 8 bits) */
 						fifo_idx += FIFO_TEMP_DATA_SIZE;
 
 						/* new temperature data */
@@ -979,7 +998,7 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 				}
 
 				if ((header->bits.timestamp_bit) || (header->bits.fsync_bit)) {
-					inv_icm426xx_format_data(s->endianess_data, &s->fifo_data[0+fifo_idx], (uint16_t *)&event.timestamp_fsync);
+					inv_icm426xx_format_data(s->endianess_data, &buf[0+fifo_idx], (uint16_t *)&event.timestamp_fsync);
 					fifo_idx += FIFO_TS_FSYNC_SIZE;
 					
 					/* new fsync event */
@@ -1003,9 +1022,9 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 					    (event.accel[2] != INVALID_VALUE_FIFO) ) {
 
 						if (header->bits.twentybits_bit) {
-							event.accel_high_res[0] = (s->fifo_data[0+fifo_idx] >> 4) & 0xF;
-							event.accel_high_res[1] = (s->fifo_data[1+fifo_idx] >> 4) & 0xF;
-							event.accel_high_res[2] = (s->fifo_data[2+fifo_idx] >> 4) & 0xF;
+							event.accel_high_res[0] = (buf[0+fifo_idx] >> 4) & 0xF;
+							event.accel_high_res[1] = (buf[1+fifo_idx] >> 4) & 0xF;
+							event.accel_high_res[2] = (buf[2+fifo_idx] >> 4) & 0xF;
 						}
 
 #if (!INV_ICM426XX_LIGHTWEIGHT_DRIVER)
@@ -1034,9 +1053,9 @@ int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s)
 					    (event.gyro[2] != INVALID_VALUE_FIFO) ) {
 
 						if (header->bits.twentybits_bit) {
-							event.gyro_high_res[0] = (s->fifo_data[0+fifo_idx]) & 0xF;
-							event.gyro_high_res[1] = (s->fifo_data[1+fifo_idx]) & 0xF;
-							event.gyro_high_res[2] = (s->fifo_data[2+fifo_idx]) & 0xF;
+							event.gyro_high_res[0] = (buf[0+fifo_idx]) & 0xF;
+							event.gyro_high_res[1] = (buf[1+fifo_idx]) & 0xF;
+							event.gyro_high_res[2] = (buf[2+fifo_idx]) & 0xF;
 						}
 
 #if (!INV_ICM426XX_LIGHTWEIGHT_DRIVER)
@@ -106,9 +106,13 @@ extern "C" {
 
 
 /** @brief Icm426xx maximum buffer size mirrored from FIFO at polling time
+ *  Define as 0 to remove the mirror from struct inv_icm426xx; the FIFO is then read
+ *  with inv_icm426xx_get_data_from_fifo_buf() into a buffer provided by the caller
  *  @warning fifo_idx type variable must be large enough to parse the FIFO_MIRRORING_SIZE
  */
+#ifndef ICM426XX_FIFO_MIRRORING_SIZE
 #define ICM426XX_FIFO_MIRRORING_SIZE 16 * 129 // packet size * max_count = 2064
+#endif
 
 /** @brief Default value for the WOM threshold
  *  Resolution of the threshold is ~= 4mg
@@ -174,7 +178,9 @@ struct inv_icm426xx {
 	int accel_st_bias[3];
 	int st_result;                                                   /**< Flag to keep track if self-test has been already run by storing acc and gyr results */
 
+#if ICM426XX_FIFO_MIRRORING_SIZE > 0
 	uint8_t fifo_data[ICM426XX_FIFO_MIRRORING_SIZE];              /**<  FIFO mirroring memory area */
+#endif
 
 	uint8_t tmst_to_reg_en_cnt;                                   /**< internal counter to keep track of the timestamp to register access availability */
 	
@@ -444,7 +450,19 @@ int inv_icm426xx_get_data_from_registers(struct inv_icm426xx * s);
  *  packet.
  *  @return 0 on success, negative value on error.
  */
+#if ICM426XX_FIFO_MIRRORING_SIZE > 0
 int inv_icm426xx_get_data_from_fifo(struct inv_icm426xx * s);
+#endif
+
+/** @brief Same as inv_icm426xx_get_data_from_fifo(), with the packets read into buf instead
+ *  of the FIFO mirror. At most len / packet size packets are read, the others are left in
+ *  the FIFO. Packets are not accessed again once parsed, so sensor_event_cb may store its
+ *  output in buf as long as it stays behind the packet being parsed.
+ *  @param[in] buf  Buffer receiving the FIFO packets
+ *  @param[in] len  Size of buf in bytes
+ *  @return number of packets read on success, negative value on error.
+ */
+int inv_icm426xx_get_data_from_fifo_buf(struct inv_icm426xx * s, uint8_t * buf, uint16_t len);
 
 /** @brief Converts ICM426XX_ACCEL_CONFIG0_ODR_t or ICM426XX_GYRO_CONFIG0_ODR_t enums to period expressed in us
  *  @param[in] odr_bitfield An ICM426XX_ACCEL_CONFIG0_ODR_t or ICM426XX_GYRO_CONFIG0_ODR_t enum
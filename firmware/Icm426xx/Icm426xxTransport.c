@@ -30,6 +30,11 @@
 /* Function definition */
 static uint8_t * get_register_cache_addr(struct inv_icm426xx * s, uint8_t reg);
 static uint8_t is_aux_interface(struct inv_icm426xx_transport *t);
+static uint8_t is_cache_valid(struct inv_icm426xx_transport *t);
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+static int read_register_cache(struct inv_icm426xx * s, uint8_t first_reg, uint8_t last_reg);
+static int select_device_bank(struct inv_icm426xx_transport *t);
+#endif
 
 
 int inv_icm426xx_init_transport(struct inv_icm426xx * s)
@@ -38,6 +43,18 @@ int inv_icm426xx_init_transport(struct inv_icm426xx * s)
 	int status = 0;
 	struct inv_icm426xx_transport *t = (struct inv_icm426xx_transport *)s;
 
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	t->register_cache.valid = 0;
+
+	if(!is_aux_interface(t)){
+		// Read contiguous cached registers in bursts
+		status |= read_register_cache(s, MPUREG_INT_CONFIG,   MPUREG_INT_CONFIG);
+		status |= read_register_cache(s, MPUREG_FIFO_CONFIG,  MPUREG_FIFO_CONFIG);
+		status |= read_register_cache(s, MPUREG_INTF_CONFIG0, MPUREG_TMST_CONFIG);
+		status |= read_register_cache(s, MPUREG_APEX_CONFIG0, MPUREG_SMD_CONFIG);
+		status |= read_register_cache(s, MPUREG_FIFO_CONFIG1, MPUREG_INT_SOURCE5);
+	}
+#else
 	if(!is_aux_interface(t)){
 		status |= t->serif.read_reg(&(t->serif), MPUREG_INTF_CONFIG1,  &(t->register_cache.intf_cfg_1_reg), 1);
 		status |= t->serif.read_reg(&(t->serif), MPUREG_PWR_MGMT_0,    &(t->register_cache.pwr_mngt_0_reg), 1);
@@ -45,9 +62,17 @@ int inv_icm426xx_init_transport(struct inv_icm426xx * s)
 		status |= t->serif.read_reg(&(t->serif), MPUREG_ACCEL_CONFIG0, &(t->register_cache.accel_cfg_0_reg), 1);
 		status |= t->serif.read_reg(&(t->serif), MPUREG_TMST_CONFIG,   &(t->register_cache.tmst_cfg_reg), 1);
 	}
+#endif
 	
 	status |= t->serif.read_reg(&(t->serif), MPUREG_REG_BANK_SEL,  &(t->register_cache.bank_sel_reg), 1);
 
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	// Until the cache is valid, all accesses go to the device
+	t->register_cache.dev_bank_sel_reg = t->register_cache.bank_sel_reg;
+	if(status == 0)
+		t->register_cache.valid = 1;
+#endif
+
 	return status;
 }
 
@@ -61,7 +86,7 @@ int inv_icm426xx_read_reg(struct inv_icm426xx * s, uint8_t reg, uint32_t len, ui
 	// Registers in cache are only in bank 0
 	// Check if bank0 is used because of duplicate register addresses between banks
 	// For AUX interface, register cache must not be used
-	if((t->register_cache.bank_sel_reg == 0) && (is_aux_interface(t) == 0)) {
+	if((t->register_cache.bank_sel_reg == 0) && (is_aux_interface(t) == 0) && is_cache_valid(t)) {
 		for(i=0; i<len ; i++) {
 			uint8_t * cache_addr  = get_register_cache_addr(s, reg+i);
 			if(cache_addr)
@@ -77,6 +102,10 @@ int inv_icm426xx_read_reg(struct inv_icm426xx * s, uint8_t reg, uint32_t len, ui
 	// Physical access to read registers
 	if((len-i) > t->serif.max_read)
 		return INV_ERROR_SIZE;
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	if(select_device_bank(t) != 0)
+		return INV_ERROR_TRANSPORT;
+#endif
 	if(t->serif.read_reg(&(t->serif), reg+i, &buf[i], len-i) != 0)
 		return INV_ERROR_TRANSPORT;
 	
@@ -93,6 +122,21 @@ int inv_icm426xx_write_reg(struct inv_icm426xx * s, uint8_t reg, uint32_t len, c
 	if(len > t->serif.max_write)
 		return INV_ERROR_SIZE;
 	
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	// Defer the bank switch to the next access reaching the device
+	if((reg == MPUREG_REG_BANK_SEL) && (len == 1) && is_cache_valid(t)) {
+		t->register_cache.bank_sel_reg = buf[0];
+		return 0;
+	}
+	
+	// Soft reset restores the power-on values of all registers, invalidate the cache until
+	// inv_icm426xx_init_transport() reads them again
+	if((reg == MPUREG_DEVICE_CONFIG) && (t->register_cache.bank_sel_reg == 0) && (buf[0] & ICM426XX_DEVICE_CONFIG_RESET_EN))
+		t->register_cache.valid = 0;
+	
+	if(select_device_bank(t) != 0)
+		return INV_ERROR_TRANSPORT;
+#endif
 	
 	for(i=0; i<len; i++) {
 		// Update bank_sel_reg in the cache
@@ -115,6 +159,9 @@ int inv_icm426xx_write_reg(struct inv_icm426xx * s, uint8_t reg, uint32_t len, c
 	// Physical access to write registers
 	if(t->serif.write_reg(&(t->serif), reg, buf, len) != 0)
 		return INV_ERROR_TRANSPORT;
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	t->register_cache.dev_bank_sel_reg = t->register_cache.bank_sel_reg;
+#endif
 
 	return 0;
 }
@@ -132,6 +179,28 @@ static uint8_t * get_register_cache_addr(struct inv_icm426xx * s, uint8_t reg)
 		case MPUREG_GYRO_CONFIG0:     return &(t->register_cache.gyro_cfg_0_reg);
 		case MPUREG_ACCEL_CONFIG0:    return &(t->register_cache.accel_cfg_0_reg);
 		case MPUREG_TMST_CONFIG:      return &(t->register_cache.tmst_cfg_reg);
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+		case MPUREG_INT_CONFIG:       return &(t->register_cache.int_cfg_reg);
+		case MPUREG_FIFO_CONFIG:      return &(t->register_cache.fifo_cfg_reg);
+		case MPUREG_INTF_CONFIG0:     return &(t->register_cache.intf_cfg_0_reg);
+		case MPUREG_GYRO_CONFIG1:     return &(t->register_cache.gyro_cfg_1_reg);
+		case MPUREG_ACCEL_GYRO_CONFIG0: return &(t->register_cache.accel_gyro_cfg_0_reg);
+		case MPUREG_ACCEL_CONFIG1:    return &(t->register_cache.accel_cfg_1_reg);
+		case MPUREG_APEX_CONFIG0:     return &(t->register_cache.apex_cfg_0_reg);
+		case MPUREG_SMD_CONFIG:       return &(t->register_cache.smd_cfg_reg);
+		case MPUREG_FIFO_CONFIG1:     return &(t->register_cache.fifo_cfg_1_reg);
+		case MPUREG_FIFO_CONFIG2:     return &(t->register_cache.fifo_cfg_2_reg);
+		case MPUREG_FIFO_CONFIG2+1:   return &(t->register_cache.fifo_cfg_3_reg);
+		case MPUREG_FSYNC_CONFIG:     return &(t->register_cache.fsync_cfg_reg);
+		case MPUREG_INT_CONFIG0:      return &(t->register_cache.int_cfg_0_reg);
+		case MPUREG_INT_CONFIG1:      return &(t->register_cache.int_cfg_1_reg);
+		case MPUREG_INT_SOURCE0:
+		case MPUREG_INT_SOURCE1:
+		case MPUREG_INT_SOURCE2:
+		case MPUREG_INT_SOURCE3:
+		case MPUREG_INT_SOURCE4:
+		case MPUREG_INT_SOURCE5:      return &(t->register_cache.int_source_reg[reg - MPUREG_INT_SOURCE0]);
+#endif
 		default:                      return (uint8_t *)0; // Not found
 	}
 }
@@ -143,3 +212,48 @@ static uint8_t is_aux_interface(struct inv_icm426xx_transport *t)
 	else
 		return 0;
 }
+
+static uint8_t is_cache_valid(struct inv_icm426xx_transport *t)
+{
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+	return t->register_cache.valid;
+#else
+	(void)t;
+	return 1;
+#endif
+}
+
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+/* Read registers first_reg to last_reg of bank 0 in one access and store the cached ones */
+static int read_register_cache(struct inv_icm426xx * s, uint8_t first_reg, uint8_t last_reg)
+{
+	struct inv_icm426xx_transport *t = (struct inv_icm426xx_transport *)s;
+	uint8_t buf[MPUREG_INT_SOURCE5 - MPUREG_FIFO_CONFIG1 + 1];
+	uint8_t len = (uint8_t)(last_reg - first_reg + 1);
+	uint8_t i;
+
+	if((len > sizeof(buf)) || (len > t->serif.max_read))
+		return INV_ERROR_SIZE;
+	if(t->serif.read_reg(&(t->serif), first_reg, buf, len) != 0)
+		return INV_ERROR_TRANSPORT;
+
+	for(i=0; i<len; i++) {
+		uint8_t * cache_addr = get_register_cache_addr(s, first_reg+i);
+		if(cache_addr)
+			*cache_addr = buf[i];
+	}
+
+	return 0;
+}
+
+/* Write the bank selected by the driver to the device if a switch was deferred */
+static int select_device_bank(struct inv_icm426xx_transport *t)
+{
+	if(t->register_cache.dev_bank_sel_reg == t->register_cache.bank_sel_reg)
+		return 0;
+	if(t->serif.write_reg(&(t->serif), MPUREG_REG_BANK_SEL, &(t->register_cache.bank_sel_reg), 1) != 0)
+		return INV_ERROR_TRANSPORT;
+	t->register_cache.dev_bank_sel_reg = t->register_cache.bank_sel_reg;
+	return 0;
+}
+#endif
@@ -44,6 +44,16 @@ extern "C" {
 /* forward declaration */
 struct inv_icm426xx;
 
+/** @brief Extend the register cache to the bank 0 configuration registers used by the
+ *  driver (interrupt, FIFO, filter, APEX and SMD configuration) and defer REG_BANK_SEL
+ *  writes until the next access reaching the device, so bank switches around accesses
+ *  served by the cache are skipped.
+ *  Set to 0 to keep only the five registers mirrored by the original driver.
+ */
+#ifndef INV_ICM426XX_EXTENDED_REG_CACHE
+#define INV_ICM426XX_EXTENDED_REG_CACHE 1
+#endif
+
 
 /** @brief enumeration  of serial interfaces available on icm426xx */
 typedef enum
@@ -81,11 +91,32 @@ struct inv_icm426xx_transport {
 		uint8_t accel_cfg_0_reg;  /**< ACCEL_CONFIG0, Bank: 0, Address: 0x50 */
 		uint8_t tmst_cfg_reg;     /**< TMST_CONFIG, Bank: 0, Address: 0x54 */
 		uint8_t bank_sel_reg;     /**< MPUREG_REG_BANK_SEL, All banks, Address 0x76*/
+#if INV_ICM426XX_EXTENDED_REG_CACHE
+		uint8_t int_cfg_reg;      /**< INT_CONFIG, Bank: 0, Address: 0x14 */
+		uint8_t fifo_cfg_reg;     /**< FIFO_CONFIG, Bank: 0, Address: 0x16 */
+		uint8_t intf_cfg_0_reg;   /**< INTF_CONFIG0, Bank: 0, Address: 0x4C */
+		uint8_t gyro_cfg_1_reg;   /**< GYRO_CONFIG1, Bank: 0, Address: 0x51 */
+		uint8_t accel_gyro_cfg_0_reg; /**< ACCEL_GYRO_CONFIG0, Bank: 0, Address: 0x52 */
+		uint8_t accel_cfg_1_reg;  /**< ACCEL_CONFIG1, Bank: 0, Address: 0x53 */
+		uint8_t apex_cfg_0_reg;   /**< APEX_CONFIG0, Bank: 0, Address: 0x56 */
+		uint8_t smd_cfg_reg;      /**< SMD_CONFIG, Bank: 0, Address: 0x57 */
+		uint8_t fifo_cfg_1_reg;   /**< FIFO_CONFIG1, Bank: 0, Address: 0x5F */
+		uint8_t fifo_cfg_2_reg;   /**< FIFO_CONFIG2, Bank: 0, Address: 0x60 */
+		uint8_t fifo_cfg_3_reg;   /**< FIFO_CONFIG3, Bank: 0, Address: 0x61 */
+		uint8_t fsync_cfg_reg;    /**< FSYNC_CONFIG, Bank: 0, Address: 0x62 */
+		uint8_t int_cfg_0_reg;    /**< INT_CONFIG0, Bank: 0, Address: 0x63 */
+		uint8_t int_cfg_1_reg;    /**< INT_CONFIG1, Bank: 0, Address: 0x64 */
+		uint8_t int_source_reg[6]; /**< INT_SOURCE0 to INT_SOURCE5, Bank: 0, Address: 0x65 to 0x6A */
+		uint8_t dev_bank_sel_reg; /**< Bank selected on the device, bank_sel_reg being the bank selected by the driver */
+		uint8_t valid;            /**< Set once the cache holds the device values, cleared by a soft reset */
+#endif
 	} register_cache; /**< Store mostly used register values on SRAM. 
 	                    *  MPUREG_OTP_SEC_STATUS_B1 and MPUREG_INT_STATUS registers
 	                    *  are read before the cache has a chance to be initialized. 
 	                    *  Therefore, these registers shall never be added to the cache 
 						*  Registers from bank 1,2,3 or 4 shall never be added to the cache
+						*  Status, data and self-clearing registers (SIGNAL_PATH_RESET) 
+						*  shall never be added to the cache
 	                    */
 };
 
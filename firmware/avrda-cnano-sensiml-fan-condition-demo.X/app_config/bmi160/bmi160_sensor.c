@@ -47,6 +47,7 @@
 // *****************************************************************************
 // *****************************************************************************
 #include "mcc_generated_files/mcc.h"
+#include "snsr_bus_stats.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -66,11 +67,177 @@
 #define _SNSRGYRORANGEEXPR(x) __SNSRGYRORANGEMACRO(x)
 #define _GET_IMU_GYRO_RANGE_MACRO() _SNSRGYRORANGEEXPR(SNSR_GYRO_RANGE)
 
+// Digital filter of both sensors: the -3dB point is about 0.4, 0.2 and 0.1 x
+// the ODR in normal, OSR2 and OSR4 mode; use the widest one at or below
+// SNSR_FILTER_HZ (normal mode when 0)
+#define BMI160_FILTER_DIV       ((SNSR_FILTER_HZ == 0 || SNSR_SAMPLE_RATE * 4UL / 10 <= SNSR_FILTER_HZ) ? 1 : \
+                                 (SNSR_SAMPLE_RATE * 2UL / 10 <= SNSR_FILTER_HZ) ? 2 : 4)
+#define BMI160_ACCEL_BW         (BMI160_FILTER_DIV == 1 ? BMI160_ACCEL_BW_NORMAL_AVG4 : \
+                                 BMI160_FILTER_DIV == 2 ? BMI160_ACCEL_BW_OSR2_AVG2 : BMI160_ACCEL_BW_OSR4_AVG1)
+#define BMI160_GYRO_BW          (BMI160_FILTER_DIV == 1 ? BMI160_GYRO_BW_NORMAL_MODE : \
+                                 BMI160_FILTER_DIV == 2 ? BMI160_GYRO_BW_OSR2_MODE : BMI160_GYRO_BW_OSR4_MODE)
+
+// Register images written by bmi160_sensor_set_config() as one burst each:
+// ACC_CONF..GYR_RANGE (0x40-0x43) and INT_EN_0..INT_MAP_2 (0x50-0x57), the
+// latter with data ready enabled on INT1 as push-pull, active high, edge
+// triggered and non-latched output
+#define BMI160_SENS_CONF_ADDR   BMI160_ACCEL_CONFIG_ADDR
+#define BMI160_INT_CONF_ADDR    BMI160_INT_ENABLE_0_ADDR
+
+// Events: single tap and high-g on INT2, with the same output settings as
+// INT1. INT_LOWHIGH_3..4 (0x5D-0x5E) hold the high-g duration, 2.5ms per
+// LSB + 2.5ms, and threshold, 1 LSB = range/256; INT_TAP_0..1 (0x63-0x64)
+// the tap timing (reset values) and threshold, 1 LSB = range/32. The event
+// status is read every SNSR_EVENT_POLL samples, so the interrupts are latched
+// for the shortest time covering that period and reset once read; data ready
+// is reset by the data read instead
+#if SNSR_EVENTS
+#define BMI160_EVENT_POLL_US    (SNSR_EVENT_POLL * 1000000UL / SNSR_SAMPLE_RATE)
+#define BMI160_EVENT_LATCH      (BMI160_EVENT_POLL_US <= 625 ? BMI160_LATCH_DUR_625_MICRO_SEC : \
+                                 BMI160_EVENT_POLL_US <= 1250 ? BMI160_LATCH_DUR_1_25_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 2500 ? BMI160_LATCH_DUR_2_5_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 5000 ? BMI160_LATCH_DUR_5_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 10000 ? BMI160_LATCH_DUR_10_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 20000 ? BMI160_LATCH_DUR_20_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 40000 ? BMI160_LATCH_DUR_40_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 80000 ? BMI160_LATCH_DUR_80_MILLI_SEC : \
+                                 BMI160_EVENT_POLL_US <= 160000 ? BMI160_LATCH_DUR_160_MILLI_SEC : \
+                                 BMI160_LATCH_DUR_320_MILLI_SEC)
+#define BMI160_EVENT_INT_EN_0   BMI160_SINGLE_TAP_INT_EN_MASK
+#define BMI160_EVENT_INT_EN_1   (BMI160_HIGH_G_X_INT_EN_MASK | BMI160_HIGH_G_Y_INT_EN_MASK | BMI160_HIGH_G_Z_INT_EN_MASK)
+#define BMI160_EVENT_INT_OUT    (BMI160_INT2_OUTPUT_EN_MASK | BMI160_INT2_OUTPUT_TYPE_MASK | BMI160_INT2_EDGE_CTRL_MASK)
+#define BMI160_EVENT_INT_MAP_2  (BMI160_INT2_SINGLE_TAP_MASK | BMI160_INT2_HIGH_G_MASK)
+#else
+#define BMI160_EVENT_LATCH      BMI160_LATCH_DUR_NONE
+#define BMI160_EVENT_INT_EN_0   0
+#define BMI160_EVENT_INT_EN_1   0
+#define BMI160_EVENT_INT_OUT    0
+#define BMI160_EVENT_INT_MAP_2  0
+#endif
+#define BMI160_EVENT_THRESHOLD(mg, lsb) (((mg) * (lsb) / (SNSR_ACCEL_RANGE * 1000UL)) < 1 ? 1 : \
+                                 ((mg) * (lsb) / (SNSR_ACCEL_RANGE * 1000UL)) > (lsb) - 1 ? (lsb) - 1 : \
+                                 ((mg) * (lsb) / (SNSR_ACCEL_RANGE * 1000UL)))
+#define BMI160_HIGH_G_CONF_ADDR BMI160_INT_LOWHIGH_3_ADDR
+#define BMI160_TAP_CONF_ADDR    BMI160_INT_TAP_0_ADDR
+#define BMI160_INT_RESET_CMD    UINT8_C(0xB1)   // CMD value clearing the latched interrupts
+
+static const uint8_t bmi160_sens_conf_image[] = {
+    (BMI160_ACCEL_BW << 4) | _GET_IMU_SAMPLE_RATE_MACRO(ACCEL),  // ACC_CONF
+    _GET_IMU_ACCEL_RANGE_MACRO(),                                // ACC_RANGE
+    (BMI160_GYRO_BW << 4) | _GET_IMU_SAMPLE_RATE_MACRO(GYRO),    // GYR_CONF
+    _GET_IMU_GYRO_RANGE_MACRO()                                  // GYR_RANGE
+};
+
+static const uint8_t bmi160_int_conf_image[] = {
+    BMI160_EVENT_INT_EN_0,              // INT_EN_0
+    BMI160_DATA_RDY_INT_EN_MASK | BMI160_EVENT_INT_EN_1, // INT_EN_1
+    0,                                  // INT_EN_2
+    BMI160_INT1_OUTPUT_EN_MASK | BMI160_INT1_OUTPUT_TYPE_MASK | BMI160_INT1_EDGE_CTRL_MASK
+        | BMI160_EVENT_INT_OUT,         // INT_OUT_CTRL
+    BMI160_EVENT_LATCH,                 // INT_LATCH
+    0,                                  // INT_MAP_0
+    BMI160_INT2_DATA_READY_MASK << 4,   // INT_MAP_1 (INT1 bits are the upper nibble)
+    BMI160_EVENT_INT_MAP_2              // INT_MAP_2
+};
+
+#if SNSR_EVENTS
+static const uint8_t bmi160_high_g_conf_image[] = {
+    7,                                  // INT_LOWHIGH_3: 20ms
+    BMI160_EVENT_THRESHOLD(SNSR_EVENT_SHAKE_MG, 256UL) // INT_LOWHIGH_4
+};
+
+static const uint8_t bmi160_tap_conf_image[] = {
+    0x04,                               // INT_TAP_0
+    BMI160_EVENT_THRESHOLD(SNSR_EVENT_TAP_MG, 32UL) // INT_TAP_1
+};
+#endif
+
+// Wake on motion: accel in low power mode at 50Hz, gyro suspended and the
+// any-motion interrupt on INT1 in place of data ready. INT_MOTION_0..1
+// (0x5F-0x60) hold the duration (consecutive samples - 1) and the threshold,
+// 1 LSB = range/512; INT_EN_0..INT_MAP_2 follow bmi160_int_conf_image
+#define BMI160_WOM_ODR          BMI160_ACCEL_ODR_50HZ
+#define BMI160_WOM_THRESHOLD    ((SNSR_WOM_THRESHOLD_MG * 512UL / (SNSR_ACCEL_RANGE * 1000UL)) < 1 ? 1 : \
+                                 (SNSR_WOM_THRESHOLD_MG * 512UL / (SNSR_ACCEL_RANGE * 1000UL)) > 255 ? 255 : \
+                                 (SNSR_WOM_THRESHOLD_MG * 512UL / (SNSR_ACCEL_RANGE * 1000UL)))
+#define BMI160_WOM_CONF_ADDR    BMI160_INT_MOTION_0_ADDR
+
+static const uint8_t bmi160_wom_conf_image[] = {
+    0,                                  // INT_MOTION_0: 1 sample
+    BMI160_WOM_THRESHOLD                // INT_MOTION_1
+};
+
+static const uint8_t bmi160_wom_int_conf_image[] = {
+    BMI160_ANY_MOTION_X_INT_EN_MASK | BMI160_ANY_MOTION_Y_INT_EN_MASK | BMI160_ANY_MOTION_Z_INT_EN_MASK, // INT_EN_0
+    0,                                  // INT_EN_1
+    0,                                  // INT_EN_2
+    BMI160_INT1_OUTPUT_EN_MASK | BMI160_INT1_OUTPUT_TYPE_MASK | BMI160_INT1_EDGE_CTRL_MASK, // INT_OUT_CTRL
+    BMI160_LATCH_DUR_NONE,              // INT_LATCH
+    BMI160_INT1_SLOPE_MASK,             // INT_MAP_0
+    0,                                  // INT_MAP_1
+    0                                   // INT_MAP_2
+};
+
+// Data registers run GYRO_X..ACCEL_Z; map SNSR_AXIS_* index to its 2 byte slot
+// and only read the span of slots covering the axes in use
+#define BMI160_AXIS_SLOT(i)     (((i) < 3) ? (i) + 3 : (i) - 3)
+#define BMI160_DATA_SLOT_FIRST  ((SNSR_AXIS_MASK & SNSR_AXIS_GYRO) ? \
+                                 BMI160_AXIS_SLOT(SNSR_AXIS_FIRST_OF(SNSR_AXIS_MASK & SNSR_AXIS_GYRO)) : \
+                                 BMI160_AXIS_SLOT(SNSR_AXIS_FIRST_OF(SNSR_AXIS_MASK & SNSR_AXIS_ACCEL)))
+#define BMI160_DATA_SLOT_LAST   ((SNSR_AXIS_MASK & SNSR_AXIS_ACCEL) ? \
+                                 BMI160_AXIS_SLOT(SNSR_AXIS_LAST_OF(SNSR_AXIS_MASK & SNSR_AXIS_ACCEL)) : \
+                                 BMI160_AXIS_SLOT(SNSR_AXIS_LAST_OF(SNSR_AXIS_MASK & SNSR_AXIS_GYRO)))
+#define BMI160_DATA_REG         (BMI160_GYRO_DATA_ADDR + 2 * BMI160_DATA_SLOT_FIRST)
+#define BMI160_DATA_LEN         (2 * (BMI160_DATA_SLOT_LAST - BMI160_DATA_SLOT_FIRST + 1))
+// Data is read through the bus callback, bypassing the driver's copy; the
+// read flag is set here on SPI
+#if SNSR_BMI160_SPI
+#define BMI160_DATA_READ_ADDR   (BMI160_DATA_REG | BMI160_SPI_RD_MASK)
+#else
+#define BMI160_DATA_READ_ADDR   BMI160_DATA_REG
+#endif
+// Without unused axes in the span, the little endian data is read straight
+// into the sample frame; it then only holds the gyro axes ahead of the accel ones
+#define BMI160_DATA_DIRECT      ((BMI160_DATA_LEN == 2 * SNSR_NUM_AXES) && SNSR_CPU_LITTLE_ENDIAN)
+#define BMI160_NUM_ACCEL_AXES   (((SNSR_AXIS_MASK >> 0) & 1) + ((SNSR_AXIS_MASK >> 1) & 1) + ((SNSR_AXIS_MASK >> 2) & 1))
+#define BMI160_NUM_GYRO_AXES    (SNSR_NUM_AXES - BMI160_NUM_ACCEL_AXES)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Serial comms implementation
 // *****************************************************************************
 // *****************************************************************************
+#if SNSR_BMI160_SPI
+// The driver sets the read/write flag in the register address
+static int8_t bmi160_spi_read (uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len) {
+    SNSR_BUS_STATS_START();
+    
+    MIKRO_CS_Clear();
+    
+    SPI0_WriteBlock(&reg_addr, 1);
+    SPI0_ReadBlock(data, len);
+    
+    MIKRO_CS_Set();
+    
+    SNSR_BUS_STATS_READ(1, len, 1);
+    return BMI160_OK;
+}
+
+static int8_t bmi160_spi_write (uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len) {
+    SNSR_BUS_STATS_START();
+    
+    /* Burst write; the register address auto-increments */
+    MIKRO_CS_Clear();
+    
+    SPI0_WriteBlock(&reg_addr, 1);
+    SPI0_WriteBlock(data, len);
+    
+    MIKRO_CS_Set();
+    
+    SNSR_BUS_STATS_WRITE(1 + len, 1);
+    return BMI160_OK;
+}
+#else
 typedef struct
 {
     size_t len;
@@ -84,21 +251,36 @@ static twi0_operations_t read_complete_handler(void *ptr)
     return I2C0_RESTART_READ;
 }
 
+#if SNSR_BUS_STATS
+static twi0_operations_t address_nack_handler(void *ptr)
+{
+    SNSR_BUS_STATS_NACK();
+    return I2C0_RESTART_WRITE;
+}
+#define BMI160_ADDRESS_NACK_HANDLER address_nack_handler
+#else
+#define BMI160_ADDRESS_NACK_HANDLER I2C0_SetRestartWriteCallback
+#endif
+
 static int8_t bmi160_i2c_read (uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len) {
     twi0_error_t ret;
     buf_t    readbuffer;
+    SNSR_BUS_STATS_START();
     
     readbuffer.data = data;
     readbuffer.len = len;
     
     while((ret = I2C0_Open(dev_addr)) == I2C0_BUSY); // sit here until we get the bus..
     I2C0_SetDataCompleteCallback(read_complete_handler, &readbuffer);
-    I2C0_SetAddressNackCallback(I2C0_SetRestartWriteCallback, NULL);
+    I2C0_SetAddressNackCallback(BMI160_ADDRESS_NACK_HANDLER, NULL);
     I2C0_SetBuffer(&reg_addr, 1);
     I2C0_MasterOperation(0);
     while((ret = I2C0_Close()) == I2C0_BUSY); // sit here until finished.
+    // Address + register, restart, address + data
+    SNSR_BUS_STATS_READ(3, len, 1);
 
     if (ret != I2C0_NOERR) {
+        SNSR_BUS_STATS_ERROR();
         return BMI160_E_COM_FAIL;
     }
     
@@ -108,6 +290,7 @@ static int8_t bmi160_i2c_read (uint8_t dev_addr, uint8_t reg_addr, uint8_t *data
 static int8_t bmi160_i2c_write (uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len) {
     twi0_error_t ret;
     static uint8_t buff [SNSR_COM_BUF_SIZE];
+    SNSR_BUS_STATS_START();
     
     if (len + 1 > SNSR_COM_BUF_SIZE)
         return BMI160_E_COM_FAIL;
@@ -118,17 +301,20 @@ static int8_t bmi160_i2c_write (uint8_t dev_addr, uint8_t reg_addr, uint8_t *dat
     }
     
     while((ret = I2C0_Open(dev_addr)) == I2C0_BUSY); // sit here until we get the bus..
-    I2C0_SetAddressNackCallback(I2C0_SetRestartWriteCallback, NULL); //NACK polling?
+    I2C0_SetAddressNackCallback(BMI160_ADDRESS_NACK_HANDLER, NULL); //NACK polling?
     I2C0_SetBuffer(buff, len+1);
     I2C0_MasterOperation(0);
     while((ret = I2C0_Close()) == I2C0_BUSY); // sit here until finished.
+    SNSR_BUS_STATS_WRITE(len + 2, 1);
     
     if (ret != I2C0_NOERR) {
+        SNSR_BUS_STATS_ERROR();
         return BMI160_E_COM_FAIL;
     }
 
     return BMI160_OK;
 }
+#endif
 
 // *****************************************************************************
 // *****************************************************************************
@@ -137,25 +323,36 @@ static int8_t bmi160_i2c_write (uint8_t dev_addr, uint8_t reg_addr, uint8_t *dat
 // *****************************************************************************
 int bmi160_sensor_read(struct sensor_device_t *sensor, snsr_data_t *ptr)
 {
-    /* Read bmi160 sensor data */
-    struct bmi160_sensor_data accel;
-    struct bmi160_sensor_data gyro;
     int status;
     
-    status = bmi160_get_sensor_data(BMI160_ACCEL_SEL | BMI160_GYRO_SEL, &accel, &gyro, &sensor->device);
+#if BMI160_DATA_DIRECT
+    /* Read bmi160 sensor data into the frame */
+    status = sensor->device.read(sensor->device.id, BMI160_DATA_READ_ADDR, (uint8_t *) ptr, BMI160_DATA_LEN);
     if (status != BMI160_OK)
-        return status;
+        return BMI160_E_COM_FAIL;
     
-    /* Convert sensor data to buffer type and write to buffer */
-#if SNSR_USE_ACCEL
-    *ptr++ = (snsr_data_t) accel.x;
-    *ptr++ = (snsr_data_t) accel.y;
-    *ptr++ = (snsr_data_t) accel.z;
+#if BMI160_NUM_ACCEL_AXES && BMI160_NUM_GYRO_AXES
+    /* Move the accel axes ahead of the gyro axes */
+    snsr_data_t gyro[BMI160_NUM_GYRO_AXES];
+    memcpy(gyro, ptr, sizeof(gyro));
+    memmove(ptr, ptr + BMI160_NUM_GYRO_AXES, BMI160_NUM_ACCEL_AXES * sizeof(snsr_data_t));
+    memcpy(ptr + BMI160_NUM_ACCEL_AXES, gyro, sizeof(gyro));
 #endif
-#if SNSR_USE_GYRO
-    *ptr++ = (snsr_data_t) gyro.x;
-    *ptr++ = (snsr_data_t) gyro.y;
-    *ptr++ = (snsr_data_t) gyro.z;
+#else
+    /* Read bmi160 sensor data */
+    uint8_t data[BMI160_DATA_LEN];
+    
+    status = sensor->device.read(sensor->device.id, BMI160_DATA_READ_ADDR, data, BMI160_DATA_LEN);
+    if (status != BMI160_OK)
+        return BMI160_E_COM_FAIL;
+    
+    /* Convert sensor data to buffer type and write to buffer */
+    for (uint8_t i = SNSR_AXIS_FIRST; i <= SNSR_AXIS_LAST; i++) {
+        if (SNSR_AXIS_MASK & (1U << i)) {
+            uint8_t const *src = &data[2 * (BMI160_AXIS_SLOT(i) - BMI160_DATA_SLOT_FIRST)];
+            *ptr++ = (snsr_data_t) ((src[1] << 8) | src[0]);
+        }
+    }
 #endif
     
     return status;
@@ -165,14 +362,29 @@ int bmi160_sensor_init(struct sensor_device_t *sensor) {
     sensor->status = BMI160_OK;
     
     /* Initialize BMI160 */
+#if SNSR_BMI160_SPI
+    sensor->device.id = 0; // not used on SPI
+    sensor->device.interface = BMI160_SPI_INTF;
+    sensor->device.read = bmi160_spi_read;
+    sensor->device.write = bmi160_spi_write;
+#else
     sensor->device.id = BMI160_I2C_ADDR;
     sensor->device.interface = BMI160_I2C_INTF;
     sensor->device.read = bmi160_i2c_read;
     sensor->device.write = bmi160_i2c_write;
+#endif
     sensor->device.delay_ms = snsr_sleep_ms;
+    sensor->device.delay_us = snsr_sleep_us;
     
     sensor->status = bmi160_init(&sensor->device);
     
+#if SNSR_BMI160_SPI
+    /* BMI160 SPI reads return data right after the address byte; the extra
+     * byte the driver reads on SPI is discarded, and on FIFO_DATA it would
+     * pop a byte off the FIFO */
+    sensor->device.dummy_byte = 0;
+#endif
+    
     return sensor->status;
 }
 
@@ -183,22 +395,40 @@ int bmi160_sensor_set_config(struct sensor_device_t *sensor) {
     /* Select the Output data rate, range of accelerometer sensor */
     sensor->device.accel_cfg.odr = _GET_IMU_SAMPLE_RATE_MACRO(ACCEL); //BMI160_ACCEL_ODR_100HZ;
     sensor->device.accel_cfg.range = _GET_IMU_ACCEL_RANGE_MACRO();//BMI160_ACCEL_RANGE_2G;
-    sensor->device.accel_cfg.bw = BMI160_ACCEL_BW_NORMAL_AVG4;
+    sensor->device.accel_cfg.bw = BMI160_ACCEL_BW;
     
     /* Select the power mode of accelerometer sensor */
+#if SNSR_USE_ACCEL
     sensor->device.accel_cfg.power = BMI160_ACCEL_NORMAL_MODE;
+#else
+    sensor->device.accel_cfg.power = BMI160_ACCEL_SUSPEND_MODE;
+#endif
     
     /* Select the Output data rate, range of Gyroscope sensor */
     sensor->device.gyro_cfg.odr = _GET_IMU_SAMPLE_RATE_MACRO(GYRO); //BMI160_GYRO_ODR_100HZ;
     sensor->device.gyro_cfg.range = _GET_IMU_GYRO_RANGE_MACRO(); //BMI160_GYRO_RANGE_2000_DPS;
-    sensor->device.gyro_cfg.bw = BMI160_GYRO_BW_NORMAL_MODE;
+    sensor->device.gyro_cfg.bw = BMI160_GYRO_BW;
 
     /* Select the power mode of Gyroscope sensor */
+#if SNSR_USE_GYRO
     sensor->device.gyro_cfg.power = BMI160_GYRO_NORMAL_MODE;
+#else
+    sensor->device.gyro_cfg.power = BMI160_GYRO_SUSPEND_MODE;
+#endif
 
-    /* Set the sensor configuration */
-    if ((sensor->status = bmi160_set_sens_conf(&sensor->device)) != BMI160_OK)
+    /* Power up first: burst writes are only allowed in normal mode. This
+     * waits out the accel and gyro start up times, and does nothing if the
+     * power modes are unchanged */
+    if ((sensor->status = bmi160_set_power_mode(&sensor->device)) != BMI160_OK)
+        return sensor->status;
+    
+    /* Write the sensor configuration */
+    sensor->status = bmi160_set_regs(BMI160_SENS_CONF_ADDR, (uint8_t *) bmi160_sens_conf_image,
+        sizeof(bmi160_sens_conf_image), &sensor->device);
+    if (sensor->status != BMI160_OK)
         return sensor->status;
+    sensor->device.prev_accel_cfg = sensor->device.accel_cfg;
+    sensor->device.prev_gyro_cfg = sensor->device.gyro_cfg;
     
 //    /* Set up fast offset compensation */
 //    struct bmi160_foc_conf foc_conf;
@@ -213,26 +443,74 @@ int bmi160_sensor_set_config(struct sensor_device_t *sensor) {
 //
 //    sensor->status = bmi160_start_foc(&foc_conf, &offsets, &sensor->device);
     
-    /* Configure sensor interrupt */
-    struct bmi160_int_settg int_config;
+#if SNSR_EVENTS
+    /* Event thresholds before the engines are enabled */
+    sensor->status = bmi160_set_regs(BMI160_HIGH_G_CONF_ADDR, (uint8_t *) bmi160_high_g_conf_image,
+        sizeof(bmi160_high_g_conf_image), &sensor->device);
+    sensor->status |= bmi160_set_regs(BMI160_TAP_CONF_ADDR, (uint8_t *) bmi160_tap_conf_image,
+        sizeof(bmi160_tap_conf_image), &sensor->device);
+    if (sensor->status != BMI160_OK)
+        return sensor->status;
+#endif
+    
+    /* Configure the data ready and event interrupts */
+    sensor->status = bmi160_set_regs(BMI160_INT_CONF_ADDR, (uint8_t *) bmi160_int_conf_image,
+        sizeof(bmi160_int_conf_image), &sensor->device);
     
-    /* Select the Interrupt channel/pin */
-    int_config.int_channel = BMI160_INT_CHANNEL_1;// Interrupt channel/pin 1
+    return sensor->status;
+}
 
-    /* Select the Interrupt type */
-    int_config.int_type = BMI160_ACC_GYRO_DATA_RDY_INT;// Choosing data ready interrupt
+int bmi160_sensor_set_wom(struct sensor_device_t *sensor, bool enable) {
+    uint8_t acc_conf = (BMI160_ACCEL_BW_OSR4_AVG1 << 4) | BMI160_WOM_ODR;
     
-    /* Select the interrupt channel/pin settings */
-    int_config.int_pin_settg.output_en = BMI160_ENABLE;// Enabling interrupt pins to act as output pin
-    int_config.int_pin_settg.output_mode = BMI160_DISABLE;// Choosing push-pull mode for interrupt pin
-    int_config.int_pin_settg.output_type = BMI160_ENABLE;// Choosing active high output
-    int_config.int_pin_settg.edge_ctrl = BMI160_ENABLE;// Choosing edge triggered output
-    int_config.int_pin_settg.input_en = BMI160_DISABLE;// Disabling interrupt pin to act as input
-    int_config.int_pin_settg.latch_dur = BMI160_LATCH_DUR_NONE;// non-latched output
-            
-    /* Set the data ready interrupt */
-    if ((sensor->status = bmi160_set_int_config(&int_config, &sensor->device)) != BMI160_OK)
+    if (!enable)
+        return bmi160_sensor_set_config(sensor);
+    if (sensor->status != BMI160_OK)
+        return sensor->status;
+    
+    /* Burst writes while still in normal mode, as in bmi160_sensor_set_config() */
+    sensor->status = bmi160_set_regs(BMI160_WOM_CONF_ADDR, (uint8_t *) bmi160_wom_conf_image,
+        sizeof(bmi160_wom_conf_image), &sensor->device);
+    sensor->status |= bmi160_set_regs(BMI160_ACCEL_CONFIG_ADDR, &acc_conf, 1, &sensor->device);
+    sensor->status |= bmi160_set_regs(BMI160_INT_CONF_ADDR, (uint8_t *) bmi160_wom_int_conf_image,
+        sizeof(bmi160_wom_int_conf_image), &sensor->device);
+    if (sensor->status != BMI160_OK)
         return sensor->status;
+    sensor->device.accel_cfg.odr = BMI160_WOM_ODR;
+    sensor->device.accel_cfg.bw = BMI160_ACCEL_BW_OSR4_AVG1;
+    
+    /* The driver sets the undersampling bit for low power mode */
+    sensor->device.accel_cfg.power = BMI160_ACCEL_LOWPOWER_MODE;
+    sensor->device.gyro_cfg.power = BMI160_GYRO_SUSPEND_MODE;
+    sensor->status = bmi160_set_power_mode(&sensor->device);
     
     return sensor->status;
-}
\ No newline at end of file
+}
+
+int bmi160_sensor_read_events(struct sensor_device_t *sensor, uint8_t nframes, uint8_t *events) {
+    static uint16_t polls = 0;
+    union bmi160_int_status int_status = { { 0 } };
+    uint8_t cmd = BMI160_INT_RESET_CMD;
+    
+    /* INT_STATUS_0..1 hold the tap and high-g bits */
+    *events = 0;
+    polls += nframes;
+    if (polls < SNSR_EVENT_POLL)
+        return sensor->status;
+    polls = 0;
+    sensor->status = bmi160_get_regs(BMI160_INT_STATUS_ADDR, int_status.data, 2, &sensor->device);
+    if (sensor->status != BMI160_OK)
+        return sensor->status;
+    
+    if (int_status.bit.s_tap)
+        *events |= SNSR_EVENT_TAP;
+    if (int_status.bit.high_g)
+        *events |= SNSR_EVENT_SHAKE;
+    
+    /* Clear the latch so that it doesn't report the events again, and the
+     * next one latches anew */
+    if (*events)
+        sensor->status = bmi160_set_regs(BMI160_COMMAND_REG_ADDR, &cmd, 1, &sensor->device);
+    
+    return sensor->status;
+}
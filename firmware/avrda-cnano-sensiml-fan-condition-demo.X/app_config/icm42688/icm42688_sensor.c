@@ -41,12 +41,14 @@
 #include <stdint.h>
 #include <string.h>
 #include "sensor.h"
+#include "Icm426xxDriver_HL_apex.h"
 // *****************************************************************************
 // *****************************************************************************
 // Section: Platform specific includes
 // *****************************************************************************
 // *****************************************************************************
 #include "mcc_generated_files/mcc.h"
+#include "snsr_bus_stats.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -69,6 +71,73 @@
 #define _SNSRGYRORANGEEXPR(x) __SNSRGYRORANGEMACRO(x)
 #define _GET_IMU_GYRO_RANGE_MACRO() _SNSRGYRORANGEEXPR(SNSR_GYRO_RANGE)
 
+#if SNSR_SAMPLE_RATE >= 1000
+/* The ODR enums >= 1kHz follow the formula: ENUM(sample_rate) = 0x6 - log2(sample_rate/1000) */
+#define _GET_IMU_ODR(x)     ((SNSR_SAMPLE_RATE >= 16000) ? 0x2 : (SNSR_SAMPLE_RATE >= 8000) ? 0x3 : \
+                             (SNSR_SAMPLE_RATE >= 4000) ? 0x4 : (SNSR_SAMPLE_RATE >= 2000) ? 0x5 : 0x6)
+#else
+#define _GET_IMU_ODR(x)     _GET_IMU_SAMPLE_RATE_MACRO(x)
+#endif
+
+// UI filters in low noise mode: the -3dB point is max(400Hz, ODR) divided by
+// 4 to 40 (BW_4..BW_40); use the widest one at or below SNSR_FILTER_HZ (BW_4
+// when 0)
+#define ICM42688_FILTER_BASE        (SNSR_SAMPLE_RATE > 400 ? SNSR_SAMPLE_RATE : 400UL)
+#define ICM42688_FILTER_FITS(d)     (ICM42688_FILTER_BASE / (d) <= SNSR_FILTER_HZ)
+#define __ICM42688FILTBWMACRO(x, d) ICM426XX_GYRO_ACCEL_CONFIG0_ ## x ## _FILT_BW_ ## d
+#define ICM42688_FILT_BW(x)         ((SNSR_FILTER_HZ == 0 || ICM42688_FILTER_FITS(4)) ? __ICM42688FILTBWMACRO(x, 4) : \
+                                     ICM42688_FILTER_FITS(5) ? __ICM42688FILTBWMACRO(x, 5) : \
+                                     ICM42688_FILTER_FITS(8) ? __ICM42688FILTBWMACRO(x, 8) : \
+                                     ICM42688_FILTER_FITS(10) ? __ICM42688FILTBWMACRO(x, 10) : \
+                                     ICM42688_FILTER_FITS(16) ? __ICM42688FILTBWMACRO(x, 16) : \
+                                     ICM42688_FILTER_FITS(20) ? __ICM42688FILTBWMACRO(x, 20) : \
+                                     __ICM42688FILTBWMACRO(x, 40))
+
+// Register image written by icm42688_sensor_set_config(); GYRO_CONFIG0 and
+// ACCEL_CONFIG0 are adjacent and go out in one burst
+#define ICM42688_GYRO_CONFIG0       (_GET_IMU_GYRO_RANGE_MACRO() | _GET_IMU_ODR(GYRO))
+#define ICM42688_ACCEL_CONFIG0      (_GET_IMU_ACCEL_RANGE_MACRO() | _GET_IMU_ODR(ACCEL))
+#define ICM42688_ACCEL_GYRO_CONFIG0 (ICM42688_FILT_BW(ACCEL) | ICM42688_FILT_BW(GYRO))
+#define ICM42688_PWR_MGMT_0         ((SNSR_USE_ACCEL ? ICM426XX_PWR_MGMT_0_ACCEL_MODE_LN : ICM426XX_PWR_MGMT_0_ACCEL_MODE_OFF) \
+                                   | (SNSR_USE_GYRO ? ICM426XX_PWR_MGMT_0_GYRO_MODE_LN : ICM426XX_PWR_MGMT_0_GYRO_MODE_OFF))
+// No register writes for 200us after a sensor leaves OFF
+#define ICM42688_PWR_ON_DELAY_US    200
+// Gyro must stay off for 150ms before it is powered on again
+#define ICM42688_GYRO_OFF_MIN_US    150000UL
+
+// Wake on motion: accel in low power mode at 50Hz, gyro off and only the WOM
+// interrupts on INT1; the threshold is in units of 1g/256
+#define ICM42688_WOM_ODR            ICM426XX_ACCEL_CONFIG0_ODR_50_HZ
+#define ICM42688_WOM_THRESHOLD      ((SNSR_WOM_THRESHOLD_MG * 256UL / 1000UL) < 1 ? 1 : \
+                                     (SNSR_WOM_THRESHOLD_MG * 256UL / 1000UL) > 255 ? 255 : \
+                                     (SNSR_WOM_THRESHOLD_MG * 256UL / 1000UL))
+// Time for the low power accel output to settle before WOM compares samples
+#define ICM42688_WOM_SETTLE_US      50000UL
+
+// Events: significant motion, two WOM events against the shake threshold
+// within the SMD window, and APEX tap detection at 200Hz to 1kHz, on INT2
+// only. The tap parameters keep their reset values; the WOM threshold is in
+// units of 1g/256
+#define ICM42688_EVENT_TAP          (SNSR_EVENTS && SNSR_SAMPLE_RATE >= 200 && SNSR_SAMPLE_RATE <= 1000)
+#define ICM42688_EVENT_THRESHOLD    (SNSR_EVENT_SHAKE_MG * 256UL / 1000UL)
+#if SNSR_EVENTS && !ICM42688_EVENT_TAP
+#warning "ICM42688 tap detection needs SNSR_SAMPLE_RATE of 200Hz to 1kHz; only shake events are reported"
+#endif
+#if SNSR_EVENTS && ((ICM42688_EVENT_THRESHOLD < 1) || (ICM42688_EVENT_THRESHOLD > 255))
+#error "SNSR_EVENT_SHAKE_MG must be 4 to 996 on the ICM42688"
+#endif
+// Wait between routing the event interrupts and turning the engines on
+#define ICM42688_EVENT_SETTLE_US    50000UL
+
+static const uint8_t icm42688_config0_image[] = { ICM42688_GYRO_CONFIG0, ICM42688_ACCEL_CONFIG0 };
+
+// Data registers run ACCEL_X..GYRO_Z in SNSR_AXIS_* order; only read the span covering the axes in use
+#define ICM42688_DATA_REG       (MPUREG_ACCEL_DATA_X0_UI + 2 * SNSR_AXIS_FIRST)
+#define ICM42688_DATA_LEN       (2 * (SNSR_AXIS_LAST - SNSR_AXIS_FIRST + 1))
+// Sensor data is set to little endian at init; without unused axes in the
+// span it is then read straight into the sample frame
+#define ICM42688_DATA_DIRECT    (SNSR_AXIS_CONTIGUOUS && SNSR_CPU_LITTLE_ENDIAN)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Serial comms implementation
@@ -77,6 +146,8 @@
 static int icm42688_spi_read (struct inv_icm426xx_serif * serif, uint8_t reg, uint8_t * rbuffer, uint32_t rlen) {
     int rval = INV_ERROR_SUCCESS;
     
+    SNSR_BUS_STATS_START();
+    
     reg = 0x80 | (reg & 0x7F); // Set Read/Write bit in MSB (1 for Read)
     
     MIKRO_CS_Clear();
@@ -86,25 +157,25 @@ static int icm42688_spi_read (struct inv_icm426xx_serif * serif, uint8_t reg, ui
     
     MIKRO_CS_Set();
     
+    SNSR_BUS_STATS_READ(1, rlen, 1);
     return rval;
 }
 
 static int icm42688_spi_write (struct inv_icm426xx_serif * serif, uint8_t reg, const uint8_t * wbuffer, uint32_t wlen) {
     int rval = INV_ERROR_SUCCESS;
-    //uint8_t *ptr = (uint8_t *) wbuffer; // ignore const (we promise we won't change it)
-    uint8_t data[2];
-    
-    for (int i=0; i<wlen; i++) 
-    {
-        data[0] = reg++ & 0x7F;
-        // data[0] |= (0 << 7); // Set Read/Write bit in MSB (0 for Write)
-        data[1] = *wbuffer++;
-        MIKRO_CS_Clear();
-        SPI0_WriteBlock(data, 2);
-        MIKRO_CS_Set();
-    }    
+    SNSR_BUS_STATS_START();
+    
+    reg &= 0x7F; // Clear Read/Write bit in MSB (0 for Write)
+    
+    /* Burst write; the register address auto-increments */
+    MIKRO_CS_Clear();
+    
+    SPI0_WriteBlock(&reg, 1);
+    SPI0_WriteBlock((void *) wbuffer, wlen); // ignore const (WriteBlock does not change it)
     
     MIKRO_CS_Set();
+    
+    SNSR_BUS_STATS_WRITE(1 + wlen, 1);
     return rval;
 }
 
@@ -114,6 +185,8 @@ static int icm42688_spi_write (struct inv_icm426xx_serif * serif, uint8_t reg, c
 // *****************************************************************************
 // *****************************************************************************
 static snsr_data_t * l_snsr_buffer = NULL;
+// INT1 sources in use before wake on motion was enabled
+static inv_icm426xx_interrupt_parameter_t l_int1_config;
 
 uint64_t inv_icm426xx_get_time_us(void) {
     return snsr_read_timer_us();
@@ -130,19 +203,15 @@ void icm42688_sensor_event_cb(inv_icm426xx_sensor_event_t * event) {
     }
     
     /* Convert sensor data to buffer type and write to buffer */
-#if SNSR_USE_ACCEL
-    *l_snsr_buffer++ = (snsr_data_t) event->accel[0];
-    *l_snsr_buffer++ = (snsr_data_t) event->accel[1];
-    *l_snsr_buffer++ = (snsr_data_t) event->accel[2];
-#endif
-#if SNSR_USE_GYRO
-    *l_snsr_buffer++ = (snsr_data_t) event->gyro[0];
-    *l_snsr_buffer++ = (snsr_data_t) event->gyro[1];
-    *l_snsr_buffer++ = (snsr_data_t) event->gyro[2];
-#endif
+    for (uint8_t i = SNSR_AXIS_FIRST; i <= SNSR_AXIS_LAST; i++) {
+        if (SNSR_AXIS_MASK & (1U << i))
+            *l_snsr_buffer++ = (snsr_data_t) ((i < 3) ? event->accel[i] : event->gyro[i - 3]);
+    }
 }
 
 int icm42688_sensor_init(struct sensor_device_t *sensor) {    
+    uint8_t data;
+    
     /* Init ICM */
     memset(&sensor->serif, 0, sizeof(sensor->serif));
     sensor->serif.context   = 0;        /* no need */
@@ -154,9 +223,23 @@ int icm42688_sensor_init(struct sensor_device_t *sensor) {
     
     sensor->status = SNSR_STATUS_OK;
 
-    // Init and disable FIFO
+    // Init and set up the FIFO; with SNSR_FIFO_READ the FIFO threshold
+    // interrupt replaces data ready on INT1
     sensor->status = inv_icm426xx_init(&sensor->device, &sensor->serif, icm42688_sensor_event_cb);
+#if SNSR_FIFO_READ
+    sensor->status |= inv_icm426xx_configure_fifo(&sensor->device, INV_ICM426XX_FIFO_ENABLED);
+    sensor->status |= inv_icm426xx_configure_fifo_wm(&sensor->device, SNSR_FIFO_WATERMARK);
+#else
     sensor->status |= inv_icm426xx_configure_fifo(&sensor->device, INV_ICM426XX_FIFO_DISABLED);
+#endif
+    
+    /* Little endian sensor data (FIFO and data registers); the driver decodes
+     * the FIFO according to endianess_data */
+    sensor->status |= inv_icm426xx_read_reg(&sensor->device, MPUREG_INTF_CONFIG0, 1, &data);
+    data &= (uint8_t) ~BIT_DATA_ENDIAN_MASK;
+    data |= (uint8_t) ICM426XX_INTF_CONFIG0_DATA_LITTLE_ENDIAN;
+    sensor->status |= inv_icm426xx_write_reg(&sensor->device, MPUREG_INTF_CONFIG0, 1, &data);
+    sensor->device.endianess_data = ICM426XX_INTF_CONFIG0_DATA_LITTLE_ENDIAN;
 
     uint8_t who_am_i;
     sensor->status |= inv_icm426xx_get_who_am_i(&sensor->device, &who_am_i);
@@ -166,42 +249,209 @@ int icm42688_sensor_init(struct sensor_device_t *sensor) {
     return sensor->status;
 }
 
-int icm42688_sensor_set_config(struct sensor_device_t *sensor) {
-    /* Configure ICM */
-    // No sync clock - disable CLKIN
-    sensor->status |= inv_icm426xx_enable_clkin_rtc(&sensor->device, false);
-
-    // Set sampling parameters
-#if SNSR_SAMPLE_RATE >= 1000
-    /* The FS macros > 1kHz follow the formula: ENUM(sample_rate) = 0x6 - log2(sample_rate/1000) */
-    uint8_t ilog2 = 0;
-    /* Note: sample rate in khz for ICM is always a power of 2 */
-    while ( ((((uint32_t) SNSR_SAMPLE_RATE / 1000U) >> ilog2) & 0x1) == 0 )
-        ilog2++;
-    uint8_t accel_sample_rate = 0x6 - ilog2;
-    uint8_t gyro_sample_rate = accel_sample_rate;
-#else
-    uint8_t accel_sample_rate = _GET_IMU_SAMPLE_RATE_MACRO(ACCEL);
-    uint8_t gyro_sample_rate = _GET_IMU_SAMPLE_RATE_MACRO(GYRO);
+#if SNSR_EVENTS
+static int icm42688_sensor_set_events(struct inv_icm426xx *s) {
+    inv_icm426xx_interrupt_parameter_t config;
+    int status;
+    
+    /* init routes SMD and WOM to INT1 too, where the data ready handler
+     * would take them for samples */
+    status = inv_icm426xx_get_config_int1(s, &config);
+    config.INV_ICM426XX_SMD = INV_ICM426XX_DISABLE;
+    config.INV_ICM426XX_WOM_X = INV_ICM426XX_DISABLE;
+    config.INV_ICM426XX_WOM_Y = INV_ICM426XX_DISABLE;
+    config.INV_ICM426XX_WOM_Z = INV_ICM426XX_DISABLE;
+    config.INV_ICM426XX_TAP_DET = INV_ICM426XX_DISABLE;
+    status |= inv_icm426xx_set_config_int1(s, &config);
+    
+    memset(&config, 0, sizeof(config));
+    config.INV_ICM426XX_SMD = INV_ICM426XX_ENABLE;
+    config.INV_ICM426XX_TAP_DET = ICM42688_EVENT_TAP ? INV_ICM426XX_ENABLE : INV_ICM426XX_DISABLE;
+    status |= inv_icm426xx_set_config_int2(s, &config);
+    
+    status |= inv_icm426xx_configure_smd_wom(s, ICM42688_EVENT_THRESHOLD, ICM42688_EVENT_THRESHOLD,
+        ICM42688_EVENT_THRESHOLD, ICM426XX_SMD_CONFIG_WOM_INT_MODE_ORED, ICM426XX_SMD_CONFIG_WOM_MODE_CMP_PREV);
+    inv_icm426xx_sleep_us(ICM42688_EVENT_SETTLE_US);
+    status |= inv_icm426xx_enable_smd(s);
+#if ICM42688_EVENT_TAP
+    status |= inv_icm426xx_enable_tap(s);
+#endif
+    
+    return status;
+}
 #endif
-    sensor->status |= inv_icm426xx_set_accel_fsr(&sensor->device, _GET_IMU_ACCEL_RANGE_MACRO()); //ICM426XX_ACCEL_CONFIG0_FS_SEL_2g);
-    sensor->status |= inv_icm426xx_set_gyro_fsr(&sensor->device, _GET_IMU_GYRO_RANGE_MACRO()); //ICM426XX_GYRO_CONFIG0_FS_SEL_2000dps);
-    sensor->status |= inv_icm426xx_set_accel_frequency(&sensor->device, accel_sample_rate); //ICM426XX_ACCEL_CONFIG0_ODR_100_HZ);
-    sensor->status |= inv_icm426xx_set_gyro_frequency(&sensor->device, gyro_sample_rate); //ICM426XX_GYRO_CONFIG0_ODR_100_HZ);
 
-    // Low Noise Mode
-    sensor->status |= inv_icm426xx_enable_accel_low_noise_mode(&sensor->device);
-    sensor->status |= inv_icm426xx_enable_gyro_low_noise_mode(&sensor->device);
+int icm42688_sensor_set_config(struct sensor_device_t *sensor) {
+    struct inv_icm426xx *s = &sensor->device;
+    uint8_t data[sizeof(icm42688_config0_image)];
+    uint8_t pwr_mgmt_0;
+    
+    /* Configure ICM from the register image; soft reset at init leaves CLKIN
+     * disabled and the UI filter order set, so only the ODR, range, filter
+     * bandwidth and power mode are written. GYRO_CONFIG0, ACCEL_CONFIG0 and
+     * PWR_MGMT_0 reads come from the transport register cache */
+    sensor->status |= inv_icm426xx_read_reg(s, MPUREG_GYRO_CONFIG0, sizeof(data), data);
+    if (memcmp(data, icm42688_config0_image, sizeof(data)) != 0)
+        sensor->status |= inv_icm426xx_write_reg(s, MPUREG_GYRO_CONFIG0, sizeof(data), icm42688_config0_image);
+    
+    data[0] = ICM42688_ACCEL_GYRO_CONFIG0;
+    sensor->status |= inv_icm426xx_write_reg(s, MPUREG_ACCEL_GYRO_CONFIG0, 1, data);
+    s->avg_bw_setting.acc_ln_bw = ICM42688_FILT_BW(ACCEL);
+    s->avg_bw_setting.gyr_ln_bw = ICM42688_FILT_BW(GYRO);
+    
+    // Low Noise Mode; power down any sensor with no axes in use
+    sensor->status |= inv_icm426xx_read_reg(s, MPUREG_PWR_MGMT_0, 1, &pwr_mgmt_0);
+    if (pwr_mgmt_0 != ICM42688_PWR_MGMT_0) {
+        uint8_t accel_was_on = (pwr_mgmt_0 & BIT_PWR_MGMT_0_ACCEL_MODE_MASK) != ICM426XX_PWR_MGMT_0_ACCEL_MODE_OFF;
+        uint8_t gyro_was_on = (pwr_mgmt_0 & BIT_PWR_MGMT_0_GYRO_MODE_MASK) != ICM426XX_PWR_MGMT_0_GYRO_MODE_OFF;
+        
+        if (s->fifo_is_used && !accel_was_on && !gyro_was_on) {
+            /* As in the driver's enable functions, the FIFO only records the
+             * sensors once one of them is enabled */
+            sensor->status |= inv_icm426xx_read_reg(s, MPUREG_FIFO_CONFIG1, 1, data);
+            data[0] |= (uint8_t) (ICM426XX_FIFO_CONFIG1_ACCEL_EN | ICM426XX_FIFO_CONFIG1_GYRO_EN);
+            if (s->fifo_highres_enabled)
+                data[0] |= (uint8_t) ICM426XX_FIFO_CONFIG1_HIRES_EN;
+            sensor->status |= inv_icm426xx_write_reg(s, MPUREG_FIFO_CONFIG1, 1, data);
+        }
+        if (SNSR_USE_GYRO && !gyro_was_on && s->gyro_power_off_tmst != UINT32_MAX) {
+            uint64_t off_us = inv_icm426xx_get_time_us() - s->gyro_power_off_tmst;
+            if (off_us < ICM42688_GYRO_OFF_MIN_US)
+                inv_icm426xx_sleep_us(ICM42688_GYRO_OFF_MIN_US - (uint32_t) off_us);
+        }
+        data[0] = ICM42688_PWR_MGMT_0;
+        sensor->status |= inv_icm426xx_write_reg(s, MPUREG_PWR_MGMT_0, 1, data);
+        if (!SNSR_USE_GYRO && gyro_was_on)
+            s->gyro_power_off_tmst = inv_icm426xx_get_time_us();
+        /* The first FIFO samples after power on are noisy; the driver drops
+         * them based on these start times */
+        if (s->fifo_is_used && SNSR_USE_ACCEL && !accel_was_on)
+            s->accel_start_time_us = inv_icm426xx_get_time_us();
+        if (s->fifo_is_used && SNSR_USE_GYRO && !gyro_was_on)
+            s->gyro_start_time_us = inv_icm426xx_get_time_us();
+        inv_icm426xx_sleep_us(ICM42688_PWR_ON_DELAY_US);
+    }
     
     // Note DRDY interrupt is set up by default in inv_init function
+#if SNSR_EVENTS
+    sensor->status |= icm42688_sensor_set_events(s);
+#endif
 
     return sensor->status;
 }
 
 int icm42688_sensor_read(struct sensor_device_t *sensor, snsr_data_t *ptr) {
-    l_snsr_buffer = ptr; // Set module scoped buffer pointer
-    sensor->status = inv_icm426xx_get_data_from_registers(&sensor->device);
+    uint8_t int_status;
+    
+    /* Ensure data ready status bit is set */
+    sensor->status = inv_icm426xx_read_reg(&sensor->device, MPUREG_INT_STATUS, 1, &int_status);
+    if ((sensor->status != SNSR_STATUS_OK) || !(int_status & BIT_INT_STATUS_DRDY))
+        return sensor->status;
+    
+#if ICM42688_DATA_DIRECT
+    /* The register span is the sample frame */
+    sensor->status = inv_icm426xx_read_reg(&sensor->device, ICM42688_DATA_REG, ICM42688_DATA_LEN, (uint8_t *) ptr);
+#else
+    uint8_t data[ICM42688_DATA_LEN];
+    
+    sensor->status = inv_icm426xx_read_reg(&sensor->device, ICM42688_DATA_REG, ICM42688_DATA_LEN, data);
+    if (sensor->status != SNSR_STATUS_OK)
+        return sensor->status;
+    
+    /* Convert sensor data to buffer type and write to buffer */
+    uint8_t const *src = data;
+    for (uint8_t i = SNSR_AXIS_FIRST; i <= SNSR_AXIS_LAST; i++, src += 2) {
+        if (SNSR_AXIS_MASK & (1U << i))
+            *ptr++ = (snsr_data_t) ((src[1] << 8) | src[0]);
+    }
+#endif
+    
+    return sensor->status;
+}
+
+int icm42688_sensor_read_fifo(struct sensor_device_t *sensor, snsr_data_t *ptr, uint16_t nframes) {
+    int count;
+    
+    /* The packets are read into the frames and decoded in place; a frame is
+     * smaller than a FIFO packet, so the event callback only overwrites
+     * packets that were already decoded */
+    l_snsr_buffer = ptr;
+    count = inv_icm426xx_get_data_from_fifo_buf(&sensor->device, (uint8_t *) ptr, nframes * SNSR_NUM_AXES * sizeof(snsr_data_t));
+    if (count >= 0)
+        count = (int) (l_snsr_buffer - ptr) / SNSR_NUM_AXES;
+    else
+        sensor->status = count;
     l_snsr_buffer = NULL;
     
+    return count;
+}
+
+int icm42688_sensor_reset_fifo(struct sensor_device_t *sensor) {
+    sensor->status = inv_icm426xx_reset_fifo(&sensor->device);
+    return sensor->status;
+}
+
+int icm42688_sensor_set_wom(struct sensor_device_t *sensor, bool enable) {
+    struct inv_icm426xx *s = &sensor->device;
+    inv_icm426xx_interrupt_parameter_t int1_wom = { (inv_icm426xx_interrupt_value) 0 };
+    
+    if (!enable) {
+        /* disable_wom() turns the FIFO threshold interrupt back on; the saved
+         * INT1 sources are restored after it */
+        sensor->status = inv_icm426xx_disable_wom(s);
+        sensor->status |= inv_icm426xx_set_config_int1(s, &l_int1_config);
+        if (sensor->status != SNSR_STATUS_OK)
+            return sensor->status;
+        return icm42688_sensor_set_config(sensor);
+    }
+    
+#if SNSR_EVENTS
+    /* The WOM engine is shared with SMD, and tap has no use in low power mode */
+    sensor->status = inv_icm426xx_disable_smd(s);
+#if ICM42688_EVENT_TAP
+    sensor->status |= inv_icm426xx_disable_tap(s);
+#endif
+    if (sensor->status != SNSR_STATUS_OK)
+        return sensor->status;
+#endif
+    
+    sensor->status = inv_icm426xx_get_config_int1(s, &l_int1_config);
+    int1_wom.INV_ICM426XX_WOM_X = INV_ICM426XX_ENABLE;
+    int1_wom.INV_ICM426XX_WOM_Y = INV_ICM426XX_ENABLE;
+    int1_wom.INV_ICM426XX_WOM_Z = INV_ICM426XX_ENABLE;
+    sensor->status |= inv_icm426xx_set_config_int1(s, &int1_wom);
+    
+    /* Gyro off first, so the accel runs from the RC oscillator in low power mode */
+    sensor->status |= inv_icm426xx_disable_gyro(s);
+    sensor->status |= inv_icm426xx_set_accel_frequency(s, ICM42688_WOM_ODR);
+    sensor->status |= inv_icm426xx_enable_accel_low_power_mode(s);
+    
+    sensor->status |= inv_icm426xx_configure_smd_wom(s, ICM42688_WOM_THRESHOLD, ICM42688_WOM_THRESHOLD,
+        ICM42688_WOM_THRESHOLD, ICM426XX_SMD_CONFIG_WOM_INT_MODE_ORED, ICM426XX_SMD_CONFIG_WOM_MODE_CMP_PREV);
+    inv_icm426xx_sleep_us(ICM42688_WOM_SETTLE_US);
+    sensor->status |= inv_icm426xx_enable_wom(s);
+    
     return sensor->status;
-}
\ No newline at end of file
+}
+
+int icm42688_sensor_read_events(struct sensor_device_t *sensor, uint8_t nframes, uint8_t *events) {
+    static uint16_t polls = 0;
+    uint8_t int_status[2];
+    
+    /* INT_STATUS2..3 (SMD, tap) hold the events until read, which clears them */
+    *events = 0;
+    polls += nframes;
+    if (polls < SNSR_EVENT_POLL)
+        return sensor->status;
+    polls = 0;
+    sensor->status = inv_icm426xx_read_reg(&sensor->device, MPUREG_INT_STATUS2, sizeof(int_status), int_status);
+    if (sensor->status != SNSR_STATUS_OK)
+        return sensor->status;
+    
+    if (int_status[1] & BIT_INT_STATUS3_TAP_DET)
+        *events |= SNSR_EVENT_TAP;
+    if (int_status[0] & BIT_INT_STATUS2_SMD_INT)
+        *events |= SNSR_EVENT_SHAKE;
+    
+    return sensor->status;
+}
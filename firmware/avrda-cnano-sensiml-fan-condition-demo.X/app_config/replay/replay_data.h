@@ -0,0 +1,515 @@
+/* Generated by host/csv2replay.py; do not edit
+ * Source: synthetic 12Hz vibration test signal, samples 0 to 499; regenerate
+ *         from a dataset recording to replay real data
+ * Axis order: AX, AY, AZ, GX, GY, GZ */
+#ifndef REPLAY_DATA_H
+#define REPLAY_DATA_H
+
+#include <stdint.h>
+
+#define REPLAY_DATA_LEN 500U
+
+static const int16_t replay_data[REPLAY_DATA_LEN][6] = {
+    {    64,    144,  16385,    -15,    -21,      0},
+    {  1317,   -143,  16389,      2,     10,    -18},
+    {  1996,     -6,  16338,     10,      6,     47},
+    {  1551,    -14,  16420,      3,     18,     -7},
+    {   261,    102,  16404,      2,    -21,      8},
+    { -1171,     72,  16390,     21,     -1,      4},
+    { -1931,   -108,  16371,    -10,     39,     -1},
+    { -1656,     61,  16375,    -31,     19,     -8},
+    {  -461,   -130,  16370,     25,     28,    -26},
+    {   896,     -4,  16405,      3,      6,    -19},
+    {  1931,    111,  16370,    -28,    -15,     15},
+    {  1722,     -9,  16354,     -2,     -4,      0},
+    {   811,     42,  16424,     -2,     -9,      7},
+    {  -878,     -3,  16388,    -24,      9,    -11},
+    { -1932,    -21,  16354,    -10,     -3,     25},
+    { -1896,     -2,  16395,    -36,     24,    -21},
+    {  -941,   -112,  16354,     -7,     37,     13},
+    {   467,    -28,  16349,      0,    -11,     14},
+    {  1620,    -33,  16358,    -14,     14,      2},
+    {  1993,    118,  16418,    -27,     10,    -35},
+    {  1172,    191,  16378,     -7,      3,      0},
+    {  -249,    -75,  16416,     17,     -4,      6},
+    { -1508,    103,  16395,     13,     -5,    -21},
+    { -2020,    101,  16413,      2,    -11,      6},
+    { -1285,    135,  16363,      0,    -29,    -22},
+    {     9,      2,  16412,     25,     16,     26},
+    {  1341,   -112,  16399,     53,      7,    -23},
+    {  2008,    142,  16352,     16,    -12,     25},
+    {  1580,     30,  16444,     -8,    -13,     37},
+    {   206,    219,  16382,    -20,      0,      2},
+    { -1165,    -19,  16416,    -46,    -11,     -5},
+    { -1873,   -199,  16373,    -22,    -13,     12},
+    { -1668,    144,  16366,      5,     23,     18},
+    {  -514,    112,  16356,     36,      3,     -2},
+    {   977,     84,  16436,     -2,     -7,     11},
+    {  1858,   -169,  16409,     -7,     22,    -20},
+    {  1664,     28,  16388,     32,     10,      6},
+    {   765,    -36,  16386,    -27,     10,    -16},
+    {  -758,     69,  16411,    -20,     40,    -11},
+    { -1767,     95,  16390,      3,     35,     17},
+    { -1879,   -182,  16361,     23,      3,    -19},
+    {  -995,    -30,  16404,      7,     19,    -16},
+    {   546,    -50,  16375,     34,      1,     -2},
+    {  1678,    -38,  16430,     27,     14,      3},
+    {  2016,     -7,  16397,      8,      1,     32},
+    {  1263,    132,  16326,     36,     14,     -9},
+    {  -251,    113,  16419,     17,      2,      0},
+    { -1499,     -9,  16357,    -12,     -2,      6},
+    { -1882,   -136,  16398,     -1,      6,     27},
+    { -1307,    -15,  16367,    -27,     -1,     24},
+    {   -13,     70,  16405,      7,     21,     -2},
+    {  1327,   -117,  16411,     -7,     -6,     16},
+    {  1956,    177,  16403,    -10,    -12,     21},
+    {  1481,    -64,  16384,      4,      0,      7},
+    {   232,    -12,  16421,     12,     -8,     34},
+    { -1275,      8,  16404,     19,      2,     -7},
+    { -1935,    -19,  16398,    -57,      7,    -15},
+    { -1641,     74,  16405,     -8,      8,     -6},
+    {  -486,    -13,  16357,     39,     14,    -41},
+    {  1008,   -139,  16377,    -11,    -10,      4},
+    {  1885,   -144,  16383,      7,     35,     -8},
+    {  1750,    -38,  16403,    -17,    -14,     11},
+    {   735,     22,  16365,    -16,     -6,     -3},
+    {  -752,     43,  16400,     10,      9,    -17},
+    { -1865,     80,  16384,      2,    -23,     -4},
+    { -1933,    -86,  16365,    -29,      1,     23},
+    {  -998,      9,  16351,     13,     37,    -24},
+    {   486,    142,  16395,      2,    -40,     -3},
+    {  1734,    143,  16403,    -11,    -13,    -36},
+    {  1910,    112,  16380,    -26,     26,    -33},
+    {  1238,    -32,  16394,     13,      5,     25},
+    {  -249,    -32,  16364,    -28,    -13,     19},
+    { -1499,    139,  16465,     14,     10,    -26},
+    { -2008,    219,  16399,     -2,      6,    -37},
+    { -1410,   -130,  16319,     15,     19,     -3},
+    {    17,   -100,  16397,     15,     30,     31},
+    {  1393,    -12,  16359,    -12,     12,     11},
+    {  1996,    166,  16403,      0,     -3,      1},
+    {  1493,    -97,  16394,    -11,     -5,     24},
+    {   241,    131,  16383,     30,      9,    -35},
+    { -1113,    -20,  16325,      2,      3,    -25},
+    { -1994,     54,  16426,     22,     24,     22},
+    { -1812,    -72,  16389,    -53,     15,     17},
+    {  -536,    -38,  16355,      0,      0,      0},
+    {   912,     38,  16373,     19,      6,    -29},
+    {  1829,      6,  16369,      9,     16,      0},
+    {  1725,   -119,  16401,    -21,     22,     -1},
+    {   762,    -88,  16381,    -59,     -4,     11},
+    {  -781,    -84,  16382,      1,    -16,     13},
+    { -1891,    111,  16341,    -16,     26,    -19},
+    { -1984,      7,  16356,    -22,    -14,    -14},
+    { -1012,   -102,  16432,    -13,     19,    -28},
+    {   524,   -125,  16370,     12,    -10,    -39},
+    {  1661,    -15,  16401,    -19,     -5,      1},
+    {  1882,    -10,  16359,      8,     -2,     -3},
+    {  1054,    -10,  16372,    -18,    -10,    -25},
+    {  -241,     65,  16401,    -10,     33,     17},
+    { -1588,    -13,  16335,     -2,     14,     25},
+    { -2016,   -178,  16378,     27,      2,     25},
+    { -1327,    156,  16401,    -13,      8,     50},
+    {   -25,   -185,  16447,      8,    -12,    -12},
+    {  1292,     70,  16388,    -12,     -8,     -8},
+    {  2049,    -18,  16425,    -16,    -12,     -9},
+    {  1514,     -9,  16414,     24,    -21,     25},
+    {   255,    158,  16378,    -16,     15,     12},
+    { -1198,      2,  16387,      6,    -34,    -24},
+    { -1961,     25,  16368,    -35,     26,     -6},
+    { -1740,    159,  16417,     20,     16,     11},
+    {  -546,      3,  16394,     12,      9,    -20},
+    {   933,    -33,  16378,    -17,    -36,    -24},
+    {  1917,     -1,  16401,    -37,     -8,     17},
+    {  1711,   -108,  16334,     24,      0,    -11},
+    {   743,     -9,  16411,     23,     18,      6},
+    {  -698,     81,  16418,    -36,      6,      1},
+    { -1801,    -24,  16381,      9,      3,      2},
+    { -1955,   -125,  16361,    -35,    -10,    -16},
+    { -1053,   -193,  16369,    -11,     43,     17},
+    {   458,    -49,  16353,    -15,     -7,      0},
+    {  1657,     82,  16403,     39,    -26,     13},
+    {  1945,   -160,  16374,    -32,      0,     54},
+    {  1240,    182,  16419,    -30,      8,      2},
+    {  -228,   -103,  16324,     42,     23,      6},
+    { -1565,     18,  16346,     19,      3,     -3},
+    { -2017,     -6,  16387,     -8,     19,      4},
+    { -1373,    -86,  16420,     25,     13,    -36},
+    {   -17,     99,  16385,     25,     -8,     15},
+    {  1395,   -244,  16371,     -4,    -12,    -17},
+    {  2075,    -11,  16407,    -26,    -41,     -9},
+    {  1561,    -72,  16399,     16,     -8,     -1},
+    {   213,    108,  16437,      9,    -10,    -14},
+    { -1189,     88,  16361,     29,    -24,      0},
+    { -1898,    178,  16371,     15,     50,     23},
+    { -1798,     28,  16455,    -23,     18,    -41},
+    {  -417,    -84,  16408,     18,    -55,    -28},
+    {   979,   -152,  16383,    -18,     26,    -10},
+    {  1856,     64,  16420,     -3,      5,      9},
+    {  1784,   -118,  16399,     -7,    -27,     17},
+    {   757,     14,  16361,     -4,     12,      9},
+    {  -777,    -90,  16394,      3,     16,    -23},
+    { -1763,    176,  16412,      2,     18,    -25},
+    { -1924,    205,  16334,    -23,     16,    -13},
+    {  -991,   -111,  16434,    -12,     -5,    -36},
+    {   535,      0,  16398,     31,      3,    -23},
+    {  1637,      8,  16423,    -23,     -4,     -2},
+    {  1997,    -89,  16393,     15,      0,     -1},
+    {  1206,     58,  16421,    -21,     24,     -4},
+    {  -307,    -55,  16346,     -4,     20,    -44},
+    { -1600,     76,  16374,     15,    -26,     -1},
+    { -2126,    -84,  16406,     24,     32,     -1},
+    { -1412,    -38,  16326,     27,     23,    -18},
+    {    91,   -135,  16400,    -16,    -34,      7},
+    {  1311,    119,  16357,      2,     -9,      2},
+    {  1964,     82,  16402,      1,     -2,     39},
+    {  1506,    -43,  16407,      0,    -32,     -2},
+    {   231,    -99,  16389,    -22,     -5,    -22},
+    { -1097,    -28,  16397,      5,     14,     -3},
+    { -1926,     12,  16310,      6,    -25,     18},
+    { -1677,    -37,  16308,    -42,    -23,     -7},
+    {  -566,    198,  16397,     -1,    -19,     -6},
+    {   951,    -44,  16381,     16,    -35,      4},
+    {  1957,   -136,  16378,     -7,    -22,     18},
+    {  1793,    114,  16396,     -5,      5,     -7},
+    {   654,    142,  16394,     23,    -36,     20},
+    {  -695,     -4,  16320,      2,    -13,     -3},
+    { -1806,    -90,  16380,      0,     29,     -2},
+    { -1784,   -118,  16379,     24,    -31,     12},
+    {  -943,    -60,  16376,     30,     -8,      5},
+    {   518,    120,  16321,    -29,    -26,     -5},
+    {  1719,     83,  16375,     30,     -1,     13},
+    {  1926,     83,  16362,     23,     17,     37},
+    {  1154,   -116,  16408,      6,    -10,    -26},
+    {  -210,   -194,  16370,     21,     -5,      9},
+    { -1516,     59,  16415,     13,     -7,    -24},
+    { -2010,    -65,  16396,     24,     15,    -13},
+    { -1359,      0,  16369,     25,     12,      7},
+    {   -61,   -262,  16361,     22,     -4,      0},
+    {  1355,     48,  16383,     34,     -2,     -5},
+    {  2067,     75,  16404,     10,      0,      6},
+    {  1567,     10,  16327,     27,     -9,    -11},
+    {   233,    -72,  16357,     -1,     17,     -5},
+    { -1151,   -135,  16406,    -22,     13,    -14},
+    { -1994,   -125,  16345,     -4,    -19,     -4},
+    { -1631,    -84,  16374,     -2,    -12,      0},
+    {  -485,    104,  16362,     -4,     -3,     24},
+    {   913,     17,  16407,     11,    -14,    -20},
+    {  1809,    -53,  16376,    -29,     16,      3},
+    {  1797,    -53,  16398,     -5,     10,     -9},
+    {   789,   -162,  16351,     36,     20,     32},
+    {  -775,     72,  16414,     18,     -3,     29},
+    { -1788,   -129,  16457,      2,     25,    -13},
+    { -1948,     88,  16408,    -14,      4,    -26},
+    { -1066,    109,  16349,     14,     21,      7},
+    {   573,     36,  16392,      0,      8,      7},
+    {  1641,     -4,  16372,     56,     24,    -15},
+    {  1994,   -175,  16385,     36,      1,     25},
+    {  1157,     45,  16395,    -43,    -16,     37},
+    {  -292,    120,  16435,      0,     20,      7},
+    { -1570,     58,  16397,    -19,     -8,    -26},
+    { -2012,     -4,  16354,    -37,     13,     25},
+    { -1414,      7,  16363,    -52,     42,      5},
+    {   -70,    126,  16405,     28,     14,     10},
+    {  1440,    -27,  16391,    -21,    -22,      4},
+    {  2007,   -158,  16395,     20,    -25,     -6},
+    {  1626,    -84,  16401,     15,      3,      2},
+    {   279,     28,  16388,    -29,      4,    -15},
+    { -1100,    221,  16417,    -43,     19,      2},
+    { -2019,   -121,  16415,    -12,     -1,      1},
+    { -1641,   -267,  16420,    -16,     -8,     12},
+    {  -479,   -231,  16402,     -3,    -20,    -12},
+    {   883,     78,  16428,    -12,     -9,    -29},
+    {  1866,   -101,  16384,     34,     21,     19},
+    {  1761,     83,  16362,    -17,     14,     -2},
+    {   860,     19,  16374,     14,    -23,     13},
+    {  -658,    -13,  16368,     22,    -22,      7},
+    { -1835,     29,  16360,     12,     11,     35},
+    { -1920,     44,  16331,    -15,      5,    -27},
+    {  -968,    -89,  16398,     11,     -9,     13},
+    {   469,     11,  16399,     11,     11,     33},
+    {  1656,    -15,  16329,     17,    -22,    -11},
+    {  1938,     41,  16375,     -5,      1,     -6},
+    {  1174,    -98,  16367,    -24,     17,     18},
+    {  -217,     33,  16365,     11,    -30,    -50},
+    { -1600,    149,  16391,     31,    -14,     20},
+    { -1916,     99,  16392,     21,     -9,     35},
+    { -1426,    -75,  16384,    -15,     35,     13},
+    {   -36,    167,  16424,     -7,     31,     23},
+    {  1343,    -55,  16393,     22,     31,     30},
+    {  1971,   -178,  16333,     30,     21,     23},
+    {  1540,      8,  16398,      9,      1,    -19},
+    {   182,     15,  16379,     28,    -21,    -39},
+    { -1273,     -3,  16434,     -6,    -14,      7},
+    { -1887,    108,  16410,     18,     -5,      1},
+    { -1667,    181,  16317,    -10,      7,     -4},
+    {  -503,    -26,  16355,     10,     25,     -7},
+    {   985,    111,  16364,     -1,    -26,     31},
+    {  1988,    -20,  16443,     17,    -36,      9},
+    {  1822,     50,  16404,     -9,     22,      6},
+    {   831,    -11,  16308,     38,     11,    -36},
+    {  -766,    -79,  16412,    -12,     23,    -10},
+    { -1761,    -61,  16348,     11,     -4,     10},
+    { -1984,   -103,  16373,     39,      7,    -33},
+    { -1121,    185,  16393,    -25,     19,     17},
+    {   604,     19,  16369,     16,    -27,     -8},
+    {  1638,    -57,  16345,    -28,    -22,      7},
+    {  1966,     -7,  16398,     15,      9,     41},
+    {  1189,     38,  16369,     21,     28,    -59},
+    {  -209,   -109,  16394,      1,    -25,    -27},
+    { -1553,    262,  16346,     -8,     -5,     -5},
+    { -1939,    205,  16382,      8,     -6,     31},
+    { -1371,     68,  16378,     22,     -1,    -16},
+    {    95,   -194,  16389,     -7,    -18,     41},
+    {  1386,    -41,  16357,      6,      0,     -4},
+    {  1962,    152,  16390,     -3,    -25,    -15},
+    {  1577,    -75,  16403,     -2,      7,      6},
+    {   228,    -26,  16381,     13,     48,     17},
+    { -1241,    222,  16380,    -13,      2,     -1},
+    { -1951,     -2,  16383,     25,     33,      1},
+    { -1609,     93,  16419,      5,      4,     15},
+    {  -545,      5,  16350,     18,      4,     11},
+    {   946,    -76,  16412,     -8,     -4,      0},
+    {  1925,      6,  16352,    -20,     20,     -6},
+    {  1797,    -88,  16411,      9,    -10,    -34},
+    {   826,    -56,  16349,     -9,    -22,      0},
+    {  -763,   -118,  16404,    -17,    -37,      6},
+    { -1837,   -108,  16333,    -14,    -12,     -9},
+    { -1927,    126,  16415,      6,     11,     -9},
+    { -1036,     53,  16425,    -13,    -13,    -13},
+    {   431,     54,  16351,     27,     33,      1},
+    {  1686,    -85,  16411,      1,    -29,    -18},
+    {  1988,    -49,  16397,      4,     28,     -1},
+    {  1228,    110,  16423,     -6,      5,     50},
+    {  -260,    -60,  16387,    -23,    -17,     -8},
+    { -1555,    100,  16351,     -3,      5,     -5},
+    { -1958,    223,  16351,    -17,    -10,    -10},
+    { -1396,     42,  16436,     49,     -1,    -41},
+    {    78,      1,  16371,     21,     -2,     -4},
+    {  1325,     92,  16409,    -17,    -11,     24},
+    {  1960,    -41,  16360,     -4,     17,      1},
+    {  1590,     60,  16323,      0,      0,    -33},
+    {   289,     -5,  16368,     10,     19,     14},
+    { -1201,     -3,  16457,    -25,      1,      0},
+    { -1889,     61,  16390,     -5,     24,      1},
+    { -1693,     16,  16404,      0,      5,     15},
+    {  -533,    -23,  16386,     13,     11,     -9},
+    {   911,    -37,  16368,     17,     12,      1},
+    {  1848,   -130,  16387,     12,      7,     -5},
+    {  1838,   -197,  16418,     30,      3,      4},
+    {   725,     89,  16356,    -11,      7,    -28},
+    {  -711,     45,  16383,     -9,     34,    -10},
+    { -1801,     80,  16383,     20,      0,      5},
+    { -1902,     65,  16364,     17,     20,    -20},
+    { -1038,   -132,  16360,     13,      1,     37},
+    {   576,   -153,  16372,     -6,     32,     15},
+    {  1735,    -81,  16444,    -22,      0,    -19},
+    {  1919,     25,  16357,     13,     10,      1},
+    {  1207,    112,  16416,    -22,     13,     17},
+    {  -269,    -38,  16420,     13,      2,     28},
+    { -1494,    173,  16372,     19,    -39,    -12},
+    { -1912,    -96,  16379,     -6,      9,     22},
+    { -1288,    -15,  16394,     17,     23,     -5},
+    {    67,   -143,  16392,    -27,     -9,    -15},
+    {  1457,    167,  16407,      3,    -39,    -33},
+    {  2005,     72,  16399,    -14,    -15,     10},
+    {  1654,     72,  16382,     -2,      8,      6},
+    {   179,    154,  16397,     11,     -9,     22},
+    { -1124,    -72,  16414,    -14,    -36,     16},
+    { -2014,    -55,  16355,     -1,     -7,      3},
+    { -1665,    163,  16397,     10,      9,     16},
+    {  -452,     28,  16349,    -19,      5,     -6},
+    {   943,    -51,  16362,     21,     15,    -25},
+    {  1911,     -1,  16370,     20,      6,      1},
+    {  1766,     95,  16391,      5,    -13,     29},
+    {   581,   -138,  16334,    -25,    -20,    -10},
+    {  -752,     19,  16424,     11,      2,     -3},
+    { -1790,     80,  16362,     34,      0,     17},
+    { -2024,     19,  16372,     27,     20,      6},
+    {  -932,    -30,  16356,     22,    -24,    -10},
+    {   439,    -94,  16371,     16,    -19,     14},
+    {  1595,    -83,  16358,     13,     26,    -46},
+    {  1968,    161,  16384,     32,     23,      5},
+    {  1105,    -66,  16430,    -17,    -21,     -9},
+    {  -187,     10,  16338,    -12,     13,     22},
+    { -1464,     51,  16398,    -19,    -11,    -27},
+    { -2003,     40,  16385,    -18,     11,     18},
+    { -1307,   -215,  16311,    -21,     10,     20},
+    {    36,      3,  16391,     -4,    -13,    -19},
+    {  1527,    -24,  16400,     10,     17,      0},
+    {  2042,    199,  16364,    -11,    -19,     -7},
+    {  1479,     33,  16404,     24,     25,     -7},
+    {   260,    -79,  16385,      1,     10,     -1},
+    { -1228,     99,  16379,    -27,    -34,     13},
+    { -2053,     67,  16429,     10,     16,     11},
+    { -1718,     22,  16328,     12,     12,      2},
+    {  -443,    -16,  16333,     28,      1,    -12},
+    {   937,    -36,  16390,    -25,      2,     -6},
+    {  1934,    -31,  16402,    -17,      7,     -5},
+    {  1862,     37,  16414,     -9,    -11,      0},
+    {   685,    -26,  16421,    -21,    -11,      1},
+    {  -655,    211,  16367,     -9,      5,    -12},
+    { -1907,     58,  16395,      5,     10,      3},
+    { -1933,     62,  16383,      3,    -21,      1},
+    {  -965,    -84,  16361,     -8,      0,    -12},
+    {   443,      7,  16347,      6,    -16,     -3},
+    {  1743,   -219,  16344,    -10,     -2,    -17},
+    {  1917,    -61,  16354,      1,    -13,     -3},
+    {  1177,     66,  16365,     -8,      8,    -42},
+    {  -247,    -89,  16409,     -6,    -17,     20},
+    { -1568,    -86,  16397,    -38,     -3,     13},
+    { -2057,     93,  16374,    -10,    -32,     27},
+    { -1303,    -33,  16394,    -37,      1,      7},
+    {   -37,    -63,  16377,    -16,    -33,     14},
+    {  1411,     56,  16405,     20,     -6,    -58},
+    {  1996,    -55,  16349,      9,    -20,    -23},
+    {  1658,    -39,  16388,     11,     11,     -2},
+    {   275,    -10,  16370,     -5,     12,     13},
+    { -1154,   -149,  16377,      9,     -7,      9},
+    { -1959,    116,  16316,      3,     20,     13},
+    { -1714,    -21,  16373,      8,     14,    -11},
+    {  -445,     44,  16322,     -7,     -2,    -13},
+    {   967,     -5,  16381,     -5,      5,    -11},
+    {  1928,   -175,  16385,     -9,     -7,      5},
+    {  1778,   -313,  16340,     -4,     -5,     -9},
+    {   704,     66,  16384,    -20,    -17,     18},
+    {  -731,     35,  16384,      4,    -10,    -19},
+    { -1857,    -86,  16435,     12,      1,     -2},
+    { -1981,     74,  16332,     20,     -9,    -27},
+    {  -891,    -96,  16375,     -3,    -29,      8},
+    {   431,    -19,  16350,     31,      0,     28},
+    {  1662,     21,  16399,      1,     -5,     21},
+    {  1982,      6,  16408,    -53,    -20,      9},
+    {  1157,    -27,  16340,     -7,     26,     -9},
+    {  -300,    -28,  16415,    -12,    -32,      4},
+    { -1558,     14,  16333,    -21,     -6,      6},
+    { -1910,    134,  16417,     18,     20,     12},
+    { -1338,    -38,  16369,     25,    -22,    -11},
+    {   -11,     18,  16364,     -9,    -15,    -14},
+    {  1349,    328,  16349,     47,    -24,      3},
+    {  1992,     61,  16374,    -21,    -10,     -6},
+    {  1467,     -9,  16386,    -29,    -26,     15},
+    {   203,    -65,  16366,    -12,     10,      4},
+    { -1071,    -36,  16394,    -13,     18,    -29},
+    { -2005,    -21,  16466,     43,     39,      0},
+    { -1764,     54,  16415,    -13,     38,     38},
+    {  -580,    -40,  16376,     -5,     -3,      0},
+    {   950,    253,  16370,    -24,     23,     19},
+    {  1845,    -87,  16358,    -42,    -25,      8},
+    {  1744,    -24,  16375,    -11,      9,      3},
+    {   797,     33,  16366,     32,      5,      9},
+    {  -721,    -32,  16356,     24,    -14,     -6},
+    { -1766,     98,  16384,     39,     -4,     46},
+    { -1834,     18,  16377,     22,    -33,     14},
+    {  -929,    156,  16425,      6,      9,    -18},
+    {   524,    -76,  16343,     34,     35,     -2},
+    {  1704,    236,  16343,     30,     -6,     12},
+    {  1960,    153,  16420,     -3,     23,     18},
+    {  1245,   -103,  16409,      0,      5,    -30},
+    {  -143,     -5,  16397,    -29,     -3,      3},
+    { -1534,   -109,  16394,     -7,     17,    -22},
+    { -1937,   -101,  16350,      9,     12,      8},
+    { -1396,    -28,  16356,     22,    -35,    -23},
+    {   -57,     51,  16339,     15,    -33,    -34},
+    {  1385,     40,  16373,     26,     -8,    -10},
+    {  1987,    133,  16378,     37,     27,     21},
+    {  1586,    129,  16398,    -46,      3,     -2},
+    {   192,   -186,  16388,    -21,      0,    -16},
+    { -1158,    -96,  16391,      0,     -9,     -5},
+    { -1951,   -264,  16326,      1,      0,      4},
+    { -1671,    -97,  16422,     15,      6,     -4},
+    {  -532,    -59,  16395,      2,     16,      4},
+    {   941,    116,  16341,    -26,      7,     -9},
+    {  1830,   -147,  16384,     27,     28,     -2},
+    {  1796,    -82,  16440,     -1,     -7,     15},
+    {   793,      3,  16420,    -25,      8,     11},
+    {  -715,     65,  16389,     11,    -41,    -14},
+    { -1767,   -110,  16357,     39,      1,      5},
+    { -1883,    172,  16376,    -16,      5,     27},
+    { -1052,    -12,  16372,      2,     13,      6},
+    {   419,    -23,  16380,      0,     21,     -6},
+    {  1657,    -16,  16384,     13,    -34,    -27},
+    {  1960,     92,  16382,      4,     34,      2},
+    {  1190,     -4,  16413,     10,     -5,     14},
+    {  -228,    -47,  16406,     40,    -21,    -21},
+    { -1546,    -19,  16391,      0,      3,     22},
+    { -1932,   -208,  16400,      0,     10,      1},
+    { -1351,    -21,  16364,     -3,     16,      0},
+    {    -3,    124,  16409,    -17,    -15,     -3},
+    {  1393,    103,  16333,     26,      1,      4},
+    {  2037,     27,  16389,     19,     23,    -22},
+    {  1462,   -104,  16391,     -5,     -3,     -9},
+    {   208,     52,  16382,      5,     10,     29},
+    { -1069,    -58,  16422,      3,      8,     22},
+    { -1993,    -12,  16413,     12,     36,     12},
+    { -1682,    -11,  16402,    -36,     25,      6},
+    {  -528,      9,  16400,    -23,     17,    -43},
+    {  1035,    -27,  16391,     -5,    -11,     19},
+    {  1854,     -7,  16400,    -24,     12,    -17},
+    {  1853,    -33,  16422,     -1,    -19,     19},
+    {   796,     94,  16340,    -21,     18,      9},
+    {  -751,    -18,  16389,    -42,    -23,    -24},
+    { -1757,    -37,  16321,     -3,     -7,    -14},
+    { -1974,    -90,  16392,     -8,     15,     26},
+    {  -980,   -158,  16354,      1,     14,     -3},
+    {   494,     21,  16420,     14,     -7,    -11},
+    {  1686,    -61,  16354,     20,      3,    -21},
+    {  1984,   -105,  16354,    -32,    -23,     -9},
+    {  1187,    -10,  16392,      0,     -9,     23},
+    {  -306,   -102,  16444,      4,      4,     52},
+    { -1595,    159,  16382,     -4,    -19,     -1},
+    { -1959,     -3,  16369,      7,     24,      0},
+    { -1390,    -40,  16395,    -12,     27,    -11},
+    {    52,    -19,  16405,    -23,     -4,    -20},
+    {  1329,     -5,  16348,     38,     33,     17},
+    {  1996,    -59,  16332,     16,    -23,     -1},
+    {  1510,     -1,  16433,     -1,     -4,     18},
+    {   224,   -194,  16360,     -5,    -15,     19},
+    { -1116,   -102,  16384,      3,     -8,    -13},
+    { -1943,    -41,  16437,      0,      0,      3},
+    { -1678,    -43,  16401,     16,      4,      7},
+    {  -566,    -44,  16386,     -6,     21,      7},
+    {   961,    -68,  16372,     -5,     32,    -24},
+    {  1947,    -38,  16432,     18,    -17,      6},
+    {  1739,     69,  16379,    -21,     -1,     11},
+    {   857,     83,  16394,     -1,    -44,    -29},
+    {  -854,   -121,  16413,     25,      5,     -8},
+    { -1775,    232,  16388,     27,     26,    -16},
+    { -1896,    -83,  16393,     -8,    -18,     13},
+    {  -967,    -25,  16409,      8,     24,     36},
+    {   434,     46,  16330,     17,     38,    -19},
+    {  1748,     67,  16395,    -44,    -21,     -7},
+    {  1967,     11,  16407,      2,     -3,    -19},
+    {  1137,    -20,  16450,     -7,     -1,     19},
+    {  -211,     61,  16386,     32,    -11,     28},
+    { -1463,     26,  16367,    -12,      5,    -39},
+    { -1932,    -85,  16347,      9,      1,    -17},
+    { -1303,   -117,  16366,    -31,     34,     11},
+    {   -71,     50,  16365,    -17,     -3,    -39},
+    {  1378,      0,  16428,    -17,    -27,    -19},
+    {  1966,     83,  16450,     11,      8,    -22},
+    {  1470,   -121,  16403,     22,     -4,    -26},
+    {   288,    -11,  16361,    -31,    -36,     30},
+    { -1199,     29,  16398,     17,     44,     -3},
+    { -1905,    -87,  16340,      0,    -39,    -30},
+    { -1727,     62,  16376,    -35,      0,    -11},
+    {  -523,    -58,  16380,     15,     10,      0},
+    {   921,   -157,  16440,     30,    -34,      7},
+    {  1921,     10,  16389,     -8,     28,      6},
+    {  1859,     28,  16389,     -9,     24,    -36},
+    {   804,    -21,  16391,    -10,    -36,    -18},
+    {  -715,    -45,  16398,    -17,    -35,     -2},
+    { -1831,    -77,  16426,    -36,      2,     -5},
+    { -1836,     12,  16394,      4,      4,     -4},
+    {  -971,     83,  16450,    -19,      4,    -21},
+    {   592,    173,  16391,     28,      4,    -23},
+    {  1777,   -155,  16352,     23,     17,     11},
+    {  1945,    -70,  16348,     24,     10,     43},
+    {  1198,     54,  16367,     -9,     10,    -15},
+    {  -198,    106,  16346,     12,      5,      4},
+    { -1557,    115,  16390,     12,      7,    -12},
+    { -2054,    166,  16435,      0,     21,     26},
+    { -1293,     96,  16380,     13,     -9,      4},
+};
+
+#endif /* REPLAY_DATA_H */
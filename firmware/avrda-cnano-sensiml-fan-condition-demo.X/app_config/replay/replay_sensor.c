@@ -0,0 +1,86 @@
+/*******************************************************************************
+  Replay Sensor Driver Interface Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    replay_sensor.c
+
+  Summary:
+    This file implements the simplified sensor API for a virtual IMU replaying
+    a recording stored in flash
+
+  Description:
+    None
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor.h"
+#include "replay_data.h"
+
+#if SNSR_SAMPLE_RATE > 1000
+#error "The replay sensor is driven from the millisecond ticker; SNSR_SAMPLE_RATE must not exceed 1000"
+#endif
+
+static void (* volatile replay_handler)(void) = NULL;
+static uint16_t replay_phase = 0;
+
+void replay_sensor_set_handler(void (*handler)(void)) {
+    replay_handler = handler;
+}
+
+void replay_sensor_tick(void) {
+    /* Spread SNSR_SAMPLE_RATE interrupts evenly over each second */
+    replay_phase += SNSR_SAMPLE_RATE;
+    if (replay_phase >= 1000U) {
+        replay_phase -= 1000U;
+        if (replay_handler != NULL)
+            replay_handler();
+    }
+}
+
+int replay_sensor_init(struct sensor_device_t *sensor) {
+    sensor->device.index = 0;
+    return (sensor->status = REPLAY_SENSOR_OK);
+}
+
+int replay_sensor_set_config(struct sensor_device_t *sensor) {
+    return (sensor->status = REPLAY_SENSOR_OK);
+}
+
+int replay_sensor_read(struct sensor_device_t *sensor, snsr_data_t *ptr) {
+    const int16_t *sample = replay_data[sensor->device.index];
+    
+    for (uint8_t i=0; i < 6; i++) {
+        if (SNSR_AXIS_MASK & (1U << i))
+            *ptr++ = (snsr_data_t) sample[i];
+    }
+    
+    if (++sensor->device.index == REPLAY_DATA_LEN)
+        sensor->device.index = 0;
+    
+    return REPLAY_SENSOR_OK;
+}
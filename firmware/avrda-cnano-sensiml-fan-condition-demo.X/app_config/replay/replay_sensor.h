@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Replay Sensor Driver Interface Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    replay_sensor.h
+
+  Summary:
+    This file defines a virtual IMU that replays a recording stored in flash
+
+  Description:
+    The samples in replay_data.h (generated from a dataset CSV file with
+    host/csv2replay.py) are played back in a loop at SNSR_SAMPLE_RATE, driven
+    from the millisecond ticker in place of the sensor data ready interrupt.
+    Allows running and profiling the application without the click board, e.g.
+    on a bare Curiosity Nano or in the MPLAB X simulator.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef REPLAY_SENSOR_H
+#define	REPLAY_SENSOR_H
+
+#include <stdint.h>
+
+#define REPLAY_SENSOR_OK    0
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+struct replay_sensor_dev {
+    uint16_t index;
+};
+
+/* Register the handler called at the sensor sample rate, i.e. the data ready interrupt */
+void replay_sensor_set_handler(void (*handler)(void));
+
+/* Must be called every millisecond */
+void replay_sensor_tick(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* REPLAY_SENSOR_H */
@@ -0,0 +1,136 @@
+/*******************************************************************************
+  Clock Scaling Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    clock_scaling.c
+
+  Summary:
+    This file contains the run time switching of the CPU clock
+
+  Notes:
+    - See clock_scaling.h
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "clock_scaling.h"
+#include "mcc_generated_files/mcc.h"
+
+#if APP_CLOCK_BOOST
+#if !CLK_IS_PROFILE(APP_CLOCK_BOOST_F_CPU)
+#error "APP_CLOCK_BOOST_F_CPU must be 4000000, 8000000, 16000000 or 24000000"
+#endif
+
+// Rates set up by USART1_Initialize() and I2C0_Initialize()
+#define CLOCK_USART1_BAUD       115200
+#define CLOCK_TWI0_SCL_HZ       100000
+
+typedef struct {
+    uint32_t hz;
+    uint16_t tca0_per;
+    uint16_t usart1_baud;
+    uint16_t uart_char_loops;   // polls of TXCIF covering one character time
+    uint8_t oschf_freqsel;
+    uint8_t tca0_clksel;
+    uint8_t tca0_ticks_per_us;
+    uint8_t spi0_presc;
+    uint8_t twi0_mbaud;
+} clock_profile_t;
+
+#define CLOCK_PROFILE(F) { \
+    .hz = (F), \
+    .tca0_per = CLK_TCA0_PER_1MS(F), \
+    .usart1_baud = (uint16_t) USART1_BAUD_RATE_F(F, CLOCK_USART1_BAUD), \
+    .uart_char_loops = (uint16_t) ((F) / (CLOCK_USART1_BAUD / 10) / 4), \
+    .oschf_freqsel = CLK_OSCHF_FREQSEL(F), \
+    .tca0_clksel = CLK_TCA0_CLKSEL(F), \
+    .tca0_ticks_per_us = CLK_TCA0_TICKS_PER_US(F), \
+    .spi0_presc = CLK_SPI0_PRESC(F), \
+    .twi0_mbaud = (uint8_t) TWI0_BAUD_F(F, CLOCK_TWI0_SCL_HZ, 0), \
+}
+
+static const clock_profile_t clock_profiles[2] = {
+    CLOCK_PROFILE(F_CPU),
+    CLOCK_PROFILE(APP_CLOCK_BOOST_F_CPU),
+};
+
+static const clock_profile_t * volatile clock_current = &clock_profiles[0];
+
+void clock_scaling_set(bool boost) {
+    const clock_profile_t *from = clock_current;
+    const clock_profile_t *to = &clock_profiles[boost ? 1 : 0];
+    uint16_t tick_us;
+    
+    if (to == from)
+        return;
+    
+    /* Let the byte in the shift register go out at the old baud rate; TXCIF
+     * is cleared below, so it only flags bytes sent since the last switch */
+    while (!(USART1.STATUS & USART_DREIF_bm)) { };
+    for (uint16_t n = from->uart_char_loops; n && !(USART1.STATUS & USART_TXCIF_bm); n--) { };
+    
+    /* The sensor interrupt uses SPI0/TWI0 and the timer */
+    ENTER_CRITICAL(R);
+    
+    /* Keep the position within the current millisecond */
+    TCA0.SINGLE.CTRLA = 0;
+    tick_us = TCA0.SINGLE.CNT / from->tca0_ticks_per_us;
+    
+    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA), to->oschf_freqsel);
+    
+    TCA0.SINGLE.PER = to->tca0_per;
+    TCA0.SINGLE.CNT = tick_us * to->tca0_ticks_per_us;
+    TCA0.SINGLE.CTRLA = to->tca0_clksel | TCA_SINGLE_ENABLE_bm;
+    
+    SPI0.CTRLA = (SPI0.CTRLA & (uint8_t) ~(SPI_PRESC_gm | SPI_CLK2X_bm)) | to->spi0_presc;
+    
+    /* MBAUD is written with the master disabled */
+    TWI0.MCTRLA &= (uint8_t) ~TWI_ENABLE_bm;
+    TWI0.MBAUD = to->twi0_mbaud;
+    TWI0.MCTRLA |= TWI_ENABLE_bm;
+    TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+    
+    USART1.BAUD = to->usart1_baud;
+    USART1.STATUS = USART_TXCIF_bm;
+    
+    clock_current = to;
+    EXIT_CRITICAL(R);
+}
+
+uint32_t clock_scaling_get_hz(void) {
+    return clock_current->hz;
+}
+
+uint16_t clock_scaling_timer_us(void) {
+    return TCA0_ReadTimer() / clock_current->tca0_ticks_per_us;
+}
+
+uint8_t clock_scaling_ticks_per_us(void) {
+    return clock_current->tca0_ticks_per_us;
+}
+
+#endif
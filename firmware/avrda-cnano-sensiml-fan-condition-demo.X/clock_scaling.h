@@ -0,0 +1,81 @@
+/*******************************************************************************
+Clock Scaling Interface Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+clock_scaling.h
+
+Summary:
+This file contains the API used to switch the CPU clock between F_CPU and
+APP_CLOCK_BOOST_F_CPU at run time
+
+Notes:
+    - Compiles to nothing unless APP_CLOCK_BOOST is enabled in app_config.h.
+    - The main loop raises the clock for a pass over the sensor buffer whose
+      samples complete a segment, so the model classifies at the boost
+      clock, and drops it back once the sensor buffer is drained. The OSCHF frequency, TCA0 (1ms tick),
+      SPI0, TWI0 and USART1 are reprogrammed on each switch, so the
+      millisecond timebase, read_timer_us() and the UART baud rate are the
+      same at either clock.
+    - A switch waits for the byte being sent on the UART to go out, for up to
+      one character time.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef CLOCK_SCALING_H
+#define	CLOCK_SCALING_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#if APP_CLOCK_BOOST
+#define CLOCK_BOOST()           clock_scaling_set(true)
+#define CLOCK_RESTORE()         clock_scaling_set(false)
+#else
+#define CLOCK_BOOST()           do {} while (0)
+#define CLOCK_RESTORE()         do {} while (0)
+#endif
+
+/* Run the CPU at APP_CLOCK_BOOST_F_CPU (boost) or at F_CPU */
+void clock_scaling_set(bool boost);
+
+/* Current CPU clock in Hz */
+uint32_t clock_scaling_get_hz(void);
+
+/* Microseconds elapsed in the current millisecond tick */
+uint16_t clock_scaling_timer_us(void);
+
+/* TCA0 counts per microsecond at the current clock */
+uint8_t clock_scaling_ticks_per_us(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CLOCK_SCALING_H */
@@ -0,0 +1,111 @@
+/*******************************************************************************
+  Decimator Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    decimator.c
+
+  Summary:
+    This file contains the CIC decimation filter feeding the model
+
+  Notes:
+    - See decimator.h
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "decimator.h"
+
+#if SML_DECIMATION > 1
+
+// Gain of the filter, SML_DECIMATION^N
+#define DECIMATOR_GAIN      (SML_DECIMATION * 1UL * (SML_DECIMATION_ORDER > 1 ? SML_DECIMATION : 1) \
+                             * (SML_DECIMATION_ORDER > 2 ? SML_DECIMATION : 1))
+
+// floor(log2(x)) for x below 2^16
+#define DECIMATOR_LOG2(x)   ((x) >= 32768U ? 15 : (x) >= 16384U ? 14 : (x) >= 8192U ? 13 : (x) >= 4096U ? 12 : \
+                             (x) >= 2048U ? 11 : (x) >= 1024U ? 10 : (x) >= 512U ? 9 : (x) >= 256U ? 8 : \
+                             (x) >= 128U ? 7 : (x) >= 64U ? 6 : (x) >= 32U ? 5 : (x) >= 16U ? 4 : \
+                             (x) >= 8U ? 3 : (x) >= 4U ? 2 : (x) >= 2U ? 1 : 0)
+
+// The registers wrap around; they only need to hold the input width plus the
+// bit growth of the filter, ceil(log2(gain))
+#define DECIMATOR_SHIFT     DECIMATOR_LOG2(DECIMATOR_GAIN)
+#define DECIMATOR_BITS      (16 + DECIMATOR_SHIFT + (DECIMATOR_GAIN > (1UL << DECIMATOR_SHIFT)))
+
+#if defined(__AVR__) && defined(__UINT24_MAX__) && (DECIMATOR_BITS <= 24)
+typedef __uint24 decimator_reg_t;
+#define DECIMATOR_REG_BITS  24
+#else
+typedef uint32_t decimator_reg_t;
+#define DECIMATOR_REG_BITS  32
+#endif
+
+// The output is shifted down by floor(log2(gain)) and the remaining gain of
+// 1 to 2 divided out with a Q14 multiply
+#define DECIMATOR_SCALE     ((int32_t) (((1UL << (14 + DECIMATOR_SHIFT)) + DECIMATOR_GAIN / 2) / DECIMATOR_GAIN))
+
+static decimator_reg_t integ[SNSR_NUM_AXES][SML_DECIMATION_ORDER];
+static decimator_reg_t comb[SNSR_NUM_AXES][SML_DECIMATION_ORDER];
+static uint8_t phase = 0;
+
+void decimator_reset(void) {
+    memset(integ, 0, sizeof(integ));
+    memset(comb, 0, sizeof(comb));
+    phase = 0;
+}
+
+bool decimator_push(snsr_data_t const *in, snsr_data_t *out) {
+    /* Integrators, at the input rate */
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++) {
+        decimator_reg_t x = (decimator_reg_t) in[i];
+        for (uint8_t n=0; n < SML_DECIMATION_ORDER; n++)
+            x = integ[i][n] += x;
+    }
+    
+    if (++phase < SML_DECIMATION)
+        return false;
+    phase = 0;
+    
+    /* Combs and gain scaling, at the output rate */
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++) {
+        decimator_reg_t x = integ[i][SML_DECIMATION_ORDER - 1];
+        for (uint8_t n=0; n < SML_DECIMATION_ORDER; n++) {
+            decimator_reg_t y = x - comb[i][n];
+            comb[i][n] = x;
+            x = y;
+        }
+        
+        /* Sign extend from the register width, then scale with rounding */
+        int32_t v = (int32_t) ((uint32_t) x << (32 - DECIMATOR_REG_BITS)) >> (32 - DECIMATOR_REG_BITS);
+        v = (((v + (1L << (DECIMATOR_SHIFT - 1))) >> DECIMATOR_SHIFT) * DECIMATOR_SCALE + (1L << 13)) >> 14;
+        out[i] = (snsr_data_t) (v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+    }
+    
+    return true;
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*******************************************************************************
+Decimator Interface Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+decimator.h
+
+Summary:
+This file contains the decimation filter API used to feed the model a stream
+at SNSR_SAMPLE_RATE / SML_DECIMATION from the full rate IMU samples
+
+Notes:
+    - Compiles to nothing unless SML_DECIMATION is above 1 in app_config.h.
+    - Cascaded integrator comb (CIC) filter of order SML_DECIMATION_ORDER with
+      a differential delay of 1. The integrators run at the input rate, the
+      combs at the output rate; the filter gain SML_DECIMATION^N is scaled out
+      so DC passes unchanged.
+    - Work per input sample and axis is N additions, plus N subtractions and
+      a 16 bit multiply per output sample and axis. The registers are 24 bit
+      on AVR when the CIC bit growth allows, 32 bit otherwise.
+    - The passband droops towards the output Nyquist frequency, e.g. by
+      about 4.8dB at 0.4 x the output rate for N=2; the model sees a different
+      response than from an IMU sampled at the model rate.
+    - Not thread safe; call from the thread running the model only.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef DECIMATOR_H
+#define	DECIMATOR_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#if SML_DECIMATION > 1
+/* Clear the filter state; the next output is SML_DECIMATION inputs away */
+void decimator_reset(void);
+
+/* Add a frame of SNSR_NUM_AXES samples at the input rate
+ * Returns true when a frame at the output rate was written to out, i.e. on
+ * every SML_DECIMATION'th call */
+bool decimator_push(snsr_data_t const *in, snsr_data_t *out);
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* DECIMATOR_H */
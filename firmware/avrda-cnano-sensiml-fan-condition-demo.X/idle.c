@@ -0,0 +1,136 @@
+/*******************************************************************************
+  Idle Sleep Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    idle.c
+
+  Summary:
+    This file contains the sleep handling of the main loop and timed delays
+
+  Notes:
+    - See idle.h
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/sleep.h>
+#include "idle.h"
+#include "profile.h"
+#include "clock_scaling.h"
+#include "mcc_generated_files/mcc.h"
+
+#if APP_IDLE_SLEEP
+
+#if APP_CLOCK_BOOST
+#define IDLE_TICKS_PER_US       clock_scaling_ticks_per_us()
+#else
+#define IDLE_TICKS_PER_US       TCA0_TICKS_PER_US
+#endif
+
+// Remainder of a delay that is waited out instead of slept; covers the time
+// taken to arm the compare and enter sleep
+#define IDLE_SPIN_US            20
+
+static uint32_t idle_deadline;
+
+#if APP_PROFILE
+static volatile bool idle_sleeping = false;
+static volatile bool idle_woken = false;
+static volatile uint32_t idle_wake_us;
+
+void idle_mark_wake(void) {
+    if (idle_sleeping && !idle_woken) {
+        idle_wake_us = (uint32_t) read_timer_us();
+        idle_woken = true;
+    }
+}
+#endif
+
+void idle_sleep(bool (*busy)(void)) {
+    cpu_irq_disable();
+    if (busy != NULL && busy()) {
+        cpu_irq_enable();
+        return;
+    }
+#if APP_PROFILE
+    uint32_t t0 = (uint32_t) read_timer_us();
+    idle_woken = false;
+    idle_sleeping = true;
+#endif
+    sleep_enable();
+    /* The instruction following sei is executed before any pending interrupt,
+     * so a wake up source that fired after the busy() check is not missed */
+    cpu_irq_enable();
+    sleep_cpu();
+    sleep_disable();
+#if APP_PROFILE
+    uint32_t t1 = (uint32_t) read_timer_us();
+    idle_sleeping = false;
+    if (idle_woken) {
+        profile_add(PROFILE_SLEEP, idle_wake_us - t0);
+        profile_add(PROFILE_WAKE, t1 - idle_wake_us);
+    }
+    else {
+        profile_add(PROFILE_SLEEP, t1 - t0);
+    }
+#endif
+}
+
+static bool idle_deadline_reached(void) {
+    return (int32_t) ((uint32_t) read_timer_us() - idle_deadline) >= 0;
+}
+
+/* Wake up from the compare channel when the deadline falls within the
+ * current timer period; otherwise the overflow does */
+static void idle_arm_compare(uint32_t us) {
+    uint32_t target = TCA0.SINGLE.CNT + us * IDLE_TICKS_PER_US;
+    
+    if (target <= TCA0.SINGLE.PER) {
+        TCA0.SINGLE.CMP0 = (uint16_t) target;
+        TCA0.SINGLE.INTFLAGS = TCA_SINGLE_CMP0_bm;
+        TCA0.SINGLE.INTCTRL |= TCA_SINGLE_CMP0_bm;
+    }
+}
+
+bool idle_delay_us(uint32_t us) {
+    if (!(SREG & CPU_I_bm))
+        return false;
+    
+    idle_deadline = (uint32_t) read_timer_us() + us;
+    while (!idle_deadline_reached()) {
+        int32_t left = (int32_t) (idle_deadline - (uint32_t) read_timer_us());
+        if (left > IDLE_SPIN_US) {
+            idle_arm_compare((uint32_t) left);
+            idle_sleep(idle_deadline_reached);
+        }
+    }
+    TCA0.SINGLE.INTCTRL &= (uint8_t) ~TCA_SINGLE_CMP0_bm;
+    return true;
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*******************************************************************************
+Idle Sleep Interface Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+idle.h
+
+Summary:
+This file contains the API used to put the CPU to sleep while the application
+has nothing to do
+
+Notes:
+    - Compiles to nothing unless APP_IDLE_SLEEP is enabled in app_config.h.
+    - The CPU sleeps in IDLE mode, as set up by SLPCTRL_Initialize(). The
+      sensor interrupt pin, UART receive and the 1ms TCA0 tick wake it up.
+      TCA0 and USART1 keep running, so a byte being sent is not cut off.
+    - Timed delays sleep until TCA0 overflows, or until TCA0 compare 0 for
+      the part of the delay below 1ms.
+    - With APP_PROFILE, the time spent asleep and the time from the sensor
+      interrupt to the main loop resuming are added to the profile report.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef IDLE_H
+#define	IDLE_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#if APP_IDLE_SLEEP
+#define IDLE_SLEEP(busy)        idle_sleep(busy)
+#else
+#define IDLE_SLEEP(busy)        do {} while (0)
+#endif
+
+#if APP_IDLE_SLEEP && APP_PROFILE
+#define IDLE_MARK_WAKE()        idle_mark_wake()
+#else
+#define IDLE_MARK_WAKE()        do {} while (0)
+#endif
+
+/* Sleep until the next interrupt, unless busy() returns true; busy is called
+ * with interrupts disabled and may be NULL */
+void idle_sleep(bool (*busy)(void));
+
+/* Sleep for us microseconds; returns false without waiting if interrupts are
+ * disabled, as no interrupt could wake the CPU up */
+bool idle_delay_us(uint32_t us);
+
+/* Called from the sensor interrupt to time the wake up of the main loop */
+void idle_mark_wake(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* IDLE_H */
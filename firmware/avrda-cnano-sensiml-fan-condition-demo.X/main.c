@@ -27,12 +27,19 @@
 #include <stdint.h>
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include <stdio.h>
+#include <string.h>
 #include "ringbuffer.h"
 #include "sensor.h"
 #include "app_config.h"
 #include "kb.h"
 #include "sml_output.h"
 #include "sml_recognition_run.h"
+#include "voting.h"
+#include "profile.h"
+#include "snsr_bus_stats.h"
+#include "clock_scaling.h"
+#include "idle.h"
+#include "decimator.h"
 // *****************************************************************************
 // *****************************************************************************
 // Section: Platform specific includes
@@ -55,10 +62,61 @@ static volatile uint32_t tickcounter = 0;
 static volatile uint16_t tickrate = 0;
 
 static struct sensor_device_t sensor;
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+/* Segments are registered with the knowledge pack in place; see sml_recognition_run_segment */
+static snsr_segment_t _snsr_buffer_data[SNSR_SEGMENT_BUF_LEN];
+static uint16_t snsr_segment_fill = 0;
+/* Set once the overlap of the segment being captured has been filled in */
+static volatile bool snsr_segment_primed = true;
+#elif SNSR_BUF_LAYOUT == SNSR_BUF_LAYOUT_SOA
+/* The ring buffer indexes the first axis column; the other axes of a sample
+ * follow at multiples of SNSR_BUF_LEN from it */
+static snsr_axisbuffer_t _snsr_buffer_data;
+#else
 static snsr_data_t _snsr_buffer_data[SNSR_BUF_LEN][SNSR_NUM_AXES];
+#endif
 static ringbuffer_t snsr_buffer;
 static volatile bool snsr_buffer_overrun = false;
 
+#if APP_WOM
+#ifndef sensor_set_wom
+#error "APP_WOM needs a sensor with a wake on motion engine"
+#endif
+/* Set while the IMU is in wake on motion mode and sampling is stopped */
+static bool wom_waiting = false;
+static volatile bool wom_motion = false;
+static uint8_t wom_off_count = 0;
+/* Start of the current state, motion interrupt time and per state totals in ms */
+static uint32_t wom_state_ms = 0;
+static volatile uint32_t wom_motion_ms;
+static uint32_t wom_active_total_ms = 0, wom_waiting_total_ms = 0;
+static bool wom_first_pending = false;
+#endif
+
+#if APP_CAPTURE
+/* Last APP_CAPTURE_LEN full rate samples, oldest at capture_index once full */
+static snsr_dataframe_t capture_data[APP_CAPTURE_LEN];
+static uint16_t capture_index = 0;
+static bool capture_full = false;
+#endif
+
+#if SNSR_EVENTS
+#ifndef sensor_read_events
+#error "SNSR_EVENTS needs a sensor with motion engines"
+#endif
+/* Events flagged by the sensor interrupt, not yet reported */
+static volatile uint8_t snsr_events = 0;
+/* Class reported provisionally for the last event, -1 once confirmed or
+ * cleared, and the classifications made since */
+static int event_class = -1;
+static uint8_t event_count = 0;
+#endif
+
+#if SML_CADENCE
+/* Classifications since the vote last changed, up to SML_CADENCE_STABLE */
+static uint8_t cadence_stable = 0;
+#endif
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Platform specific stub definitions
@@ -98,6 +156,9 @@ static void Ticker_Callback() {
     static uint32_t mstick = 0;
 
     ++tickcounter;
+#if SNSR_TYPE_REPLAY
+    replay_sensor_tick();
+#endif
     if (tickrate == 0 || mstick > tickrate) {
         mstick = 0;
     }
@@ -116,16 +177,131 @@ uint64_t read_timer_us(void) {
 }
 
 void sleep_ms(uint32_t ms) {
+#if APP_IDLE_SLEEP
+    if (idle_delay_us(ms * 1000UL))
+        return;
+#endif
     uint32_t t0 = read_timer_ms();
     while ((read_timer_ms() - t0) < ms) { };
 }
 
 void sleep_us(uint32_t us) {
+#if APP_IDLE_SLEEP
+    if (idle_delay_us(us))
+        return;
+#endif
     uint32_t t0 = read_timer_us();
     while ((read_timer_us() - t0) < us) { };
 }
 
 // For handling read of the sensor data
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+static void SNSR_ISR_HANDLER() {
+    /* Check if any errors we've flagged have been acknowledged */
+    if ((sensor.status != SNSR_STATUS_OK) || snsr_buffer_overrun)
+        return;
+    
+    ringbuffer_size_t wrcnt;
+    snsr_segment_t *ptr = ringbuffer_get_write_buffer(&snsr_buffer, &wrcnt);
+    snsr_dataframe_t frame;
+    
+    if (wrcnt == 0)
+        snsr_buffer_overrun = true;
+    else if ((sensor.status = sensor_read(&sensor, frame)) == SNSR_STATUS_OK) {
+        /* Store the frame in the per axis columns of the segment being captured */
+        for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+            (*ptr)[i][snsr_segment_fill] = frame[i];
+        
+        /* Segment complete; publish it to the reader */
+        if (++snsr_segment_fill == SML_SEGMENT_LEN) {
+#if SML_SEGMENT_HOP < SML_SEGMENT_LEN
+            /* The reader didn't get to copy in the overlap in time */
+            if (!snsr_segment_primed) {
+                snsr_buffer_overrun = true;
+                return;
+            }
+            snsr_segment_primed = false;
+#endif
+            snsr_segment_fill = SML_SEGMENT_LEN - SML_SEGMENT_HOP;
+            ringbuffer_advance_write_index(&snsr_buffer, 1);
+        }
+    }
+}
+
+#if SML_SEGMENT_HOP < SML_SEGMENT_LEN
+// Seed the segment being captured with the tail of the segment just completed
+static void Segment_Overlap_Copy(snsr_segment_t const *seg) {
+    snsr_segment_t *next = &_snsr_buffer_data[(seg - _snsr_buffer_data + 1) & (SNSR_SEGMENT_BUF_LEN - 1)];
+    
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+        memcpy(&(*next)[i][0], &(*seg)[i][SML_SEGMENT_HOP], (SML_SEGMENT_LEN - SML_SEGMENT_HOP) * sizeof(snsr_data_t));
+    
+    __ringbuffer_sync();
+    snsr_segment_primed = true;
+}
+#endif
+#elif SNSR_BUF_LAYOUT == SNSR_BUF_LAYOUT_SOA
+// Adapters between sample frames and the per axis columns of the sensor buffer
+static void Snsr_Frame_Scatter(snsr_data_t *slot, snsr_data_t const *frame) {
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+        slot[i * SNSR_BUF_LEN] = frame[i];
+}
+
+static void Snsr_Frame_Gather(snsr_data_t *frame, snsr_data_t const *slot) {
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+        frame[i] = slot[i * SNSR_BUF_LEN];
+}
+
+static void SNSR_ISR_HANDLER() {
+    /* Check if any errors we've flagged have been acknowledged */
+    if ((sensor.status != SNSR_STATUS_OK) || snsr_buffer_overrun)
+        return;
+    
+    ringbuffer_size_t wrcnt;
+    snsr_data_t *ptr = ringbuffer_get_write_buffer(&snsr_buffer, &wrcnt);
+    snsr_dataframe_t frame;
+    
+    if (wrcnt == 0)
+        snsr_buffer_overrun = true;
+    else if ((sensor.status = sensor_read(&sensor, frame)) == SNSR_STATUS_OK) {
+        Snsr_Frame_Scatter(ptr, frame);
+        ringbuffer_advance_write_index(&snsr_buffer, 1);
+    }
+}
+#elif SNSR_FIFO_READ
+// Frames for the drain when the free region before the buffer wraps around
+// is too short to read a FIFO packet into
+static snsr_dataframe_t snsr_fifo_frames[SNSR_FIFO_PACKET_FRAMES];
+// Frames the last interrupt drained
+static uint8_t snsr_fifo_count = 0;
+#define SNSR_ISR_FRAMES     snsr_fifo_count
+
+static void SNSR_ISR_HANDLER() {
+    snsr_fifo_count = 0;
+    
+    /* Check if any errors we've flagged have been acknowledged */
+    if ((sensor.status != SNSR_STATUS_OK) || snsr_buffer_overrun)
+        return;
+    
+    ringbuffer_size_t wrcnt;
+    snsr_data_t *ptr = ringbuffer_get_write_buffer(&snsr_buffer, &wrcnt);
+    int count;
+    
+    /* Packets that don't fit stay in the FIFO for the next interrupt */
+    if (wrcnt == 0)
+        snsr_buffer_overrun = true;
+    else if (wrcnt >= SNSR_FIFO_PACKET_FRAMES) {
+        if ((count = sensor_read_fifo(&sensor, ptr, wrcnt)) > 0) {
+            ringbuffer_advance_write_index(&snsr_buffer, (ringbuffer_size_t) count);
+            snsr_fifo_count = (uint8_t) count;
+        }
+    }
+    else if ((count = sensor_read_fifo(&sensor, snsr_fifo_frames[0], SNSR_FIFO_PACKET_FRAMES)) > 0) {
+        ringbuffer_write(&snsr_buffer, snsr_fifo_frames, (ringbuffer_size_t) count);
+        snsr_fifo_count = (uint8_t) count;
+    }
+}
+#else
 static void SNSR_ISR_HANDLER() {
     /* Check if any errors we've flagged have been acknowledged */
     if ((sensor.status != SNSR_STATUS_OK) || snsr_buffer_overrun)
@@ -139,6 +315,304 @@ static void SNSR_ISR_HANDLER() {
     else if ((sensor.status = sensor_read(&sensor, ptr)) == SNSR_STATUS_OK)
         ringbuffer_advance_write_index(&snsr_buffer, 1);
 }
+#endif
+
+#if SNSR_EVENTS
+#ifndef SNSR_ISR_FRAMES
+#define SNSR_ISR_FRAMES     1
+#endif
+
+// Collect the motion engine events along with the samples
+static void SNSR_ISR_EVENTS() {
+    uint8_t events;
+    
+    SNSR_ISR_HANDLER();
+    if ((sensor.status != SNSR_STATUS_OK) || snsr_buffer_overrun)
+        return;
+    if ((sensor.status = sensor_read_events(&sensor, SNSR_ISR_FRAMES, &events)) == SNSR_STATUS_OK)
+        snsr_events |= events;
+}
+#define SNSR_ISR_READ       SNSR_ISR_EVENTS
+#else
+#define SNSR_ISR_READ       SNSR_ISR_HANDLER
+#endif
+
+#if APP_PROFILE
+static void SNSR_ISR_PROFILED() {
+    IDLE_MARK_WAKE();
+    PROFILE_START(PROFILE_SNSR_ISR);
+    SNSR_ISR_READ();
+    PROFILE_END(PROFILE_SNSR_ISR);
+}
+#define SNSR_ISR_CALLBACK   SNSR_ISR_PROFILED
+#else
+#define SNSR_ISR_CALLBACK   SNSR_ISR_READ
+#endif
+
+static void Snsr_Buffer_Reset() {
+#if SNSR_FIFO_READ
+    /* The FIFO stops when full, and with it the threshold interrupt */
+    sensor_reset_fifo(&sensor);
+#endif
+    ringbuffer_reset(&snsr_buffer);
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+    snsr_segment_fill = 0;
+    snsr_segment_primed = true;
+#endif
+#if SML_DECIMATION > 1
+    decimator_reset();
+#endif
+    snsr_buffer_overrun = false;
+}
+
+#if APP_CLOCK_BOOST && (SML_INGEST_MODE == SML_INGEST_MODE_STREAM)
+// Raise the clock for a pass over nframes buffered samples only when they
+// complete the segment in progress, i.e. the model classifies during the pass
+#define CLOCK_BOOST_DUE(nframes)    do { \
+        if (sml_recognition_segment_due(((nframes) + SML_DECIMATION - 1) / SML_DECIMATION)) \
+            CLOCK_BOOST(); \
+    } while (0)
+#else
+#define CLOCK_BOOST_DUE(nframes)    CLOCK_BOOST()
+#endif
+
+#if SML_DECIMATION > 1
+// Consumer of the full rate samples, ahead of the decimator
+static void Fullrate_Consume(snsr_data_t const *frame) {
+#if APP_CAPTURE
+    memcpy(capture_data[capture_index], frame, sizeof(snsr_dataframe_t));
+    if (++capture_index == APP_CAPTURE_LEN) {
+        capture_index = 0;
+        capture_full = true;
+    }
+#else
+    (void) frame;
+#endif
+}
+
+// Feed a full rate sample to its consumer and the decimator; the model runs
+// on every SML_DECIMATION'th sample and its result is returned, -1 otherwise
+static int Decimate_Run(snsr_data_t const *frame) {
+    snsr_dataframe_t out;
+    bool ready;
+    
+    Fullrate_Consume(frame);
+    PROFILE_START(PROFILE_DECIMATE);
+    ready = decimator_push(frame, out);
+    PROFILE_END(PROFILE_DECIMATE);
+    if (!ready)
+        return -1;
+    
+    PROFILE_START(PROFILE_MODEL);
+    int ret = sml_recognition_run(out, SNSR_NUM_AXES);
+    PROFILE_END(PROFILE_MODEL);
+    return ret;
+}
+#endif
+
+#if APP_CAPTURE
+// Print the captured full rate samples, oldest first, with sampling stopped;
+// the model then restarts on fresh samples
+static void Capture_Report() {
+    uint16_t n = capture_full ? APP_CAPTURE_LEN : capture_index;
+    uint16_t i = capture_full ? capture_index : 0;
+    
+    MIKRO_INT_CallbackRegister(Null_Handler);
+    printf("capture: %u samples at %dHz\n", n, SNSR_SAMPLE_RATE);
+    while (n--) {
+        for (uint8_t j=0; j < SNSR_NUM_AXES; j++)
+            printf(j ? ",%d" : "%d", capture_data[i][j]);
+        printf("\n");
+        if (++i == APP_CAPTURE_LEN)
+            i = 0;
+    }
+    capture_index = 0;
+    capture_full = false;
+    Snsr_Buffer_Reset();
+    sml_recognition_reset();
+    MIKRO_INT_CallbackRegister(SNSR_ISR_CALLBACK);
+}
+#endif
+
+#if APP_WOM
+static void WOM_ISR_HANDLER() {
+    if (!wom_motion) {
+        wom_motion_ms = (uint32_t) read_timer_ms();
+        wom_motion = true;
+    }
+}
+
+// Stop sampling and wait for motion with the IMU in low power mode
+static void Wom_Enter() {
+    uint32_t now = (uint32_t) read_timer_ms();
+    
+    MIKRO_INT_CallbackRegister(Null_Handler);
+    if ((sensor.status = sensor_set_wom(&sensor, true)) != SNSR_STATUS_OK)
+        return;
+    Snsr_Buffer_Reset();
+    
+    wom_active_total_ms += now - wom_state_ms;
+    printf("wom: waiting for motion after %lums active (total active %lus, waiting %lus)\n",
+        (unsigned long) (now - wom_state_ms), (unsigned long) (wom_active_total_ms / 1000U),
+        (unsigned long) (wom_waiting_total_ms / 1000U));
+    wom_state_ms = now;
+    wom_off_count = 0;
+    wom_motion = false;
+    wom_waiting = true;
+    MIKRO_INT_CallbackRegister(WOM_ISR_HANDLER);
+}
+
+// Restore the sampling configuration and restart the model from scratch
+static void Wom_Exit() {
+    uint32_t now = wom_motion_ms;
+    
+    MIKRO_INT_CallbackRegister(Null_Handler);
+    if ((sensor.status = sensor_set_wom(&sensor, false)) != SNSR_STATUS_OK)
+        return;
+    Snsr_Buffer_Reset();
+    sml_recognition_reset();
+    voting_reset();
+    
+    wom_waiting_total_ms += now - wom_state_ms;
+    printf("wom: motion after %lums waiting (total active %lus, waiting %lus)\n",
+        (unsigned long) (now - wom_state_ms), (unsigned long) (wom_active_total_ms / 1000U),
+        (unsigned long) (wom_waiting_total_ms / 1000U));
+    wom_state_ms = now;
+    wom_first_pending = true;
+    wom_waiting = false;
+    MIKRO_INT_CallbackRegister(SNSR_ISR_CALLBACK);
+}
+
+static void Wom_Classification_Update(int ret) {
+    if (wom_first_pending) {
+        wom_first_pending = false;
+        printf("wom: first classification %lums after motion\n",
+            (unsigned long) ((uint32_t) read_timer_ms() - wom_state_ms));
+    }
+    wom_off_count = (ret == APP_WOM_OFF_CLASS) ? wom_off_count + 1 : 0;
+}
+#endif
+
+#if APP_IDLE_SLEEP
+// Checked with interrupts disabled before the main loop goes to sleep
+static bool App_Is_Busy() {
+    return ringbuffer_get_read_items(&snsr_buffer) > 0
+        || snsr_buffer_overrun || sensor.status != SNSR_STATUS_OK
+#if APP_WOM
+        || wom_motion
+#endif
+#if SNSR_EVENTS
+        || snsr_events
+#endif
+#if SNSR_BUS_STATS || APP_CAPTURE
+        || ringbuffer_get_read_items(&uartRxBuffer) > 0
+#endif
+        ;
+}
+#endif
+
+// Show a class on the LEDs
+static void Class_Indicate(int clsid) {
+    tickrate = 0;
+    LED_ALL_Off();
+    if (clsid == 2) {
+        tickrate = 100;
+    }
+    else if (clsid == 6) {
+        tickrate = 50;
+    }
+    else if (clsid == 0) {
+        tickrate = 50;
+    }
+    else if (clsid == 3) {
+        tickrate = 1000u;
+    }
+    else if (clsid == 4) {
+        tickrate = 600u;
+    }
+    else if (clsid == 5) {
+        tickrate = 300u;
+    }
+    else if (clsid == 1) {
+        LED_STATUS_On();
+    }
+    else {
+        tickrate = TICK_RATE_SLOW;
+    }
+}
+
+#if SNSR_EVENTS
+// Report a motion engine event at once as a provisional classification
+static void Event_Alert() {
+    uint8_t events;
+    int clsid;
+    
+    ENTER_CRITICAL(R);
+    events = snsr_events;
+    snsr_events = 0;
+    EXIT_CRITICAL(R);
+    
+    clsid = (events & SNSR_EVENT_TAP) ? APP_EVENT_TAP_CLASS : APP_EVENT_SHAKE_CLASS;
+    /* One alert at a time, and none for the class already selected */
+    if (event_class >= 0 || clsid == voting_get_class())
+        return;
+    event_class = clsid;
+    event_count = 0;
+    sml_output_event(0, (uint16_t) clsid, "provisional");
+    Class_Indicate(clsid);
+}
+
+// Confirm or clear the provisional class from the model classifications
+static void Event_Classification_Update() {
+    if (event_class < 0)
+        return;
+    if (voting_get_class() == event_class)
+        sml_output_event(0, (uint16_t) event_class, "confirmed");
+    else if (++event_count >= APP_EVENT_CONFIRM_COUNT) {
+        sml_output_event(0, (uint16_t) event_class, "cleared");
+        if (voting_get_class() >= 0)
+            Class_Indicate(voting_get_class());
+    }
+    else
+        return;
+    event_class = -1;
+}
+#endif
+
+#if SML_CADENCE
+// Let the model skip segments while the vote holds; a new class or an event
+// awaiting confirmation brings it back to every segment
+static void Cadence_Classification_Update(int clsid) {
+    if (clsid >= 0 || voting_get_class() < 0
+#if SNSR_EVENTS
+        || event_class >= 0
+#endif
+        )
+        cadence_stable = 0;
+    else if (cadence_stable < SML_CADENCE_STABLE)
+        cadence_stable++;
+    sml_recognition_set_cadence((cadence_stable >= SML_CADENCE_STABLE) ? SML_CADENCE_SKIP : 0);
+}
+#endif
+
+// For post processing of the model output
+static void Classification_Update(int ret) {
+#if APP_WOM
+    Wom_Classification_Update(ret);
+#endif
+    /* Use a majority voting scheme for prediction post processing */
+    int clsid = voting_update(ret);
+
+    /* Only touch the LEDs if we decided on a new class */
+    if (clsid >= 0)
+        Class_Indicate(clsid);
+#if SNSR_EVENTS
+    Event_Classification_Update();
+#endif
+#if SML_CADENCE
+    Cadence_Classification_Update(clsid);
+#endif
+}
 
 // *****************************************************************************
 // *****************************************************************************
@@ -164,8 +638,13 @@ int main ( void )
     while (1)
     {
         /* Initialize the sensor data buffer */
+#if (SML_INGEST_MODE == SML_INGEST_MODE_STREAM) && (SNSR_BUF_LAYOUT == SNSR_BUF_LAYOUT_SOA)
+        if (ringbuffer_init(&snsr_buffer, _snsr_buffer_data[0], SNSR_BUF_LEN, sizeof(_snsr_buffer_data[0][0])))
+            break;
+#else
         if (ringbuffer_init(&snsr_buffer, _snsr_buffer_data, sizeof(_snsr_buffer_data) / sizeof(_snsr_buffer_data[0]), sizeof(_snsr_buffer_data[0])))
             break;
+#endif
     
         /* Initialize the UART RX buffer */
         if (ringbuffer_init(&uartRxBuffer, _uartRxBuffer_data, sizeof(_uartRxBuffer_data) / sizeof(_uartRxBuffer_data[0]), sizeof(_uartRxBuffer_data[0])))
@@ -187,6 +666,13 @@ int main ( void )
 
         printf("sensor type is %s\n", SNSR_NAME);
         printf("sensor sample rate set at %dHz\n", SNSR_SAMPLE_RATE);
+#if SNSR_FIFO_READ
+        printf("sensor FIFO drained above %d samples\n", SNSR_FIFO_WATERMARK);
+#endif
+#if SML_DECIMATION > 1
+        printf("decimating by %d (CIC order %d) to %dHz for the model\n", SML_DECIMATION, SML_DECIMATION_ORDER, SML_SAMPLE_RATE);
+#endif
+        printf("sensor axis mask set at 0x%02x (%d axes)\n", SNSR_AXIS_MASK, SNSR_NUM_AXES);
 #if SNSR_USE_ACCEL
         printf("accelerometer enabled with range set at +/-%dGs\n", SNSR_ACCEL_RANGE);
 #else
@@ -201,6 +687,16 @@ int main ( void )
         /* Initialize SensiML Knowledge Pack */
         kb_model_init();
         sml_output_init(NULL);
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+        printf("segment ingestion enabled with %d sample segments every %d samples\n", SML_SEGMENT_LEN, SML_SEGMENT_HOP);
+#endif
+#if SML_GATE
+        printf("energy gate reports class %d below %d LSB peak to peak\n", SML_GATE_CLASS, SML_GATE_THRESHOLD);
+#endif
+#if SML_CADENCE
+        printf("adaptive cadence skips up to %lu segments, model run at least every %dms\n",
+            (unsigned long) SML_CADENCE_SKIP, SML_CADENCE_MAX_LATENCY_MS);
+#endif
         
         /* Display the model knowledge pack UUID */
         const uint8_t *ptr = kb_get_model_uuid_ptr(0);
@@ -215,7 +711,10 @@ int main ( void )
         printf("\n");        
 
         /* Activate External Interrupt Controller for sensor capture */
-        MIKRO_INT_CallbackRegister(SNSR_ISR_HANDLER);
+        MIKRO_INT_CallbackRegister(SNSR_ISR_CALLBACK);
+#if APP_PROFILE
+        profile_init();
+#endif
 
         /* STATE CHANGE - Application successfully initialized */
         tickrate = 0;
@@ -229,18 +728,38 @@ int main ( void )
         break;
     }
     
-    // Use a majority voting scheme for prediction post processing
-#define NUM_CLASSES 7U
-#define NUM_VOTES   3U    
-#define MAJORITY_VOTES ((NUM_VOTES + 1) / 2U)
-    int clsid = 1;
-    int votehist[NUM_VOTES] = {1};
-    int votecounts[NUM_CLASSES] = {0};
     while (!app_failed)
     {
         /* Maintain state machines of all system modules. */
         SYS_Tasks ( );
 
+#if APP_PROFILE
+        static uint32_t profile_tick = 0;
+        if ((uint32_t) read_timer_ms() - profile_tick >= APP_PROFILE_REPORT_MS) {
+            profile_tick = (uint32_t) read_timer_ms();
+            profile_report();
+        }
+#endif
+
+#if SNSR_BUS_STATS || APP_CAPTURE
+        uint8_t cmd;
+        if (UART_Read(&cmd, 1) == 1) {
+#if SNSR_BUS_STATS
+            if (cmd == SNSR_BUS_STATS_CMD)
+                snsr_bus_stats_report();
+#endif
+#if APP_CAPTURE
+            if (cmd == APP_CAPTURE_CMD)
+                Capture_Report();
+#endif
+        }
+#endif
+
+#if SNSR_EVENTS
+        if (snsr_events)
+            Event_Alert();
+#endif
+
         if (sensor.status != SNSR_STATUS_OK) {
             printf("ERROR: Got a bad sensor status: %d\n", sensor.status);
             break;
@@ -257,74 +776,94 @@ int main ( void )
 
             // Clear OVERFLOW
             MIKRO_INT_CallbackRegister(Null_Handler);
-            ringbuffer_reset(&snsr_buffer);
-            snsr_buffer_overrun = false;
-            MIKRO_INT_CallbackRegister(SNSR_ISR_HANDLER);
+            Snsr_Buffer_Reset();
+            MIKRO_INT_CallbackRegister(SNSR_ISR_CALLBACK);
 
             /* STATE CHANGE - Application is running inference model */
             tickrate = TICK_RATE_SLOW;
             continue;
         }
+#if APP_WOM
+        else if (wom_waiting) {
+            if (wom_motion)
+                Wom_Exit();
+            else
+                IDLE_SLEEP(App_Is_Busy);
+            continue;
+        }
+        else if (wom_off_count >= APP_WOM_OFF_COUNT) {
+            Wom_Enter();
+            continue;
+        }
+#endif
         else {
             ringbuffer_size_t rdcnt;
+#if APP_CLOCK_BOOST || APP_IDLE_SLEEP
+            if (ringbuffer_get_read_items(&snsr_buffer) == 0) {
+                IDLE_SLEEP(App_Is_Busy);
+                continue;
+            }
+#endif
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+            snsr_segment_t *ptr = (snsr_segment_t *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+            CLOCK_BOOST();
+            while (rdcnt--) {
+#if SML_SEGMENT_HOP < SML_SEGMENT_LEN
+                Segment_Overlap_Copy(ptr);
+#endif
+                PROFILE_START(PROFILE_MODEL);
+                int ret = sml_recognition_run_segment((snsr_data_t *) ptr++, SML_SEGMENT_LEN, SNSR_NUM_AXES);
+                PROFILE_END(PROFILE_MODEL);
+                ringbuffer_advance_read_index(&snsr_buffer, 1);
+                
+                if (ret >= 0)
+                    Classification_Update(ret);
+            }
+#elif SNSR_BUF_LAYOUT == SNSR_BUF_LAYOUT_SOA
+            snsr_data_t const *ptr = (snsr_data_t const *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+            CLOCK_BOOST_DUE(rdcnt);
+            while (rdcnt--) {
+                snsr_dataframe_t frame;
+                Snsr_Frame_Gather(frame, ptr++);
+#if SML_DECIMATION > 1
+                int ret = Decimate_Run(frame);
+#else
+                PROFILE_START(PROFILE_MODEL);
+                int ret = sml_recognition_run(frame, SNSR_NUM_AXES);
+                PROFILE_END(PROFILE_MODEL);
+#endif
+                ringbuffer_advance_read_index(&snsr_buffer, 1);
+                
+                if (ret >= 0)
+                    Classification_Update(ret);
+            }
+#elif SML_DECIMATION > 1
             snsr_dataframe_t const *ptr = (snsr_dataframe_t const *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+            CLOCK_BOOST_DUE(rdcnt);
             while (rdcnt--) {
-                int ret = sml_recognition_run((snsr_data_t *) ptr++, SNSR_NUM_AXES);
+                int ret = Decimate_Run(*ptr++);
                 ringbuffer_advance_read_index(&snsr_buffer, 1);
                 
-                if (ret >= 0) {                    
-                    /* Update the voting counts */
-                    votecounts[votehist[0]]--;
-                    for (int i=1; i < NUM_VOTES; i++)
-                        votehist[i-1] = votehist[i];
-                    votehist[NUM_VOTES-1] = ret;
-                    votecounts[ret]++;
-                    
-                    /* If there's a new state that is consistently classified as the same class, update the class ID */
-                    if (ret != clsid) {
-                        /* Get the class with the most votes */
-                        int maxval = -1, maxcls = -1;
-                        for (int i=0; i < NUM_CLASSES; i++) {
-                            if (votecounts[i] > maxval) {
-                                maxval = votecounts[i];
-                                maxcls = i;
-                            }
-                        }
-
-                        /* Only touch the LEDs if we decided on a new class */
-                        if (maxval >= MAJORITY_VOTES && maxcls != clsid) {
-                            clsid = maxcls;
-
-                            tickrate = 0;
-                            LED_ALL_Off();
-                            if (clsid == 2) {
-                                tickrate = 100;
-                            }
-                            else if (clsid == 6) {
-                                tickrate = 50;
-                            }
-                            else if (clsid == 0) {
-                                tickrate = 50;
-                            }
-                            else if (clsid == 3) {
-                                tickrate = 1000u;
-                            }
-                            else if (clsid == 4) {
-                                tickrate = 600u;
-                            }
-                            else if (clsid == 5) {
-                                tickrate = 300u;
-                            }                            
-                            else if (clsid == 1) {
-                                LED_STATUS_On();
-                            }
-                            else {
-                                tickrate = TICK_RATE_SLOW;
-                            }
-                        }
-                    }                 
-                }
+                if (ret >= 0)
+                    Classification_Update(ret);
+            }
+#else
+            snsr_dataframe_t const *ptr = (snsr_dataframe_t const *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+            CLOCK_BOOST_DUE(rdcnt);
+            while (rdcnt) {
+                int nframes;
+                PROFILE_START(PROFILE_MODEL);
+                int ret = sml_recognition_run_batch((snsr_data_t *) ptr, rdcnt, SNSR_NUM_AXES, &nframes);
+                PROFILE_END(PROFILE_MODEL);
+                ringbuffer_advance_read_index(&snsr_buffer, nframes);
+                ptr += nframes;
+                rdcnt -= nframes;
+                
+                if (ret >= 0)
+                    Classification_Update(ret);
             }
+#endif
+            CLOCK_RESTORE();
         }
     }
 
@@ -34,8 +34,44 @@
 #ifndef CLOCK_CONFIG_H
 #define CLOCK_CONFIG_H
 
+/* CPU clock profile: OSCHF at 4, 8, 16 or 24MHz, with no main clock prescaler.
+ * The peripheral settings below are derived from it */
 #ifndef F_CPU
 #define F_CPU 4000000
 #endif
 
+/* Highest SPI0 SCK, the BMI160 limit by default. SPI0 runs at F/4, or at the
+ * next divider that does not exceed it */
+#ifndef SPI0_SCK_MAX_HZ
+#define SPI0_SCK_MAX_HZ         10000000UL
+#endif
+
+/* Peripheral settings for a CPU clock F of 4, 8, 16 or 24MHz:
+ *  - OSCHF frequency select (CLKCTRL.OSCHFCTRLA)
+ *  - TCA0 clock select (TCA0.SINGLE.CTRLA); TCA0 runs at 1MHz where a
+ *    prescaler allows it, 3MHz at 24MHz, and overflows every millisecond
+ *  - SPI0 PRESC and CLK2X bits (SPI0.CTRLA) */
+#define CLK_IS_PROFILE(F)       ((F) == 4000000 || (F) == 8000000 || (F) == 16000000 || (F) == 24000000)
+#define CLK_OSCHF_FREQSEL(F)    ((F) == 24000000 ? 0x24 : (F) == 16000000 ? 0x1C : (F) == 8000000 ? 0x14 : 0x0C)
+#define CLK_TCA0_CLK_DIV(F)     ((F) == 16000000 ? 16 : ((F) == 8000000 || (F) == 24000000) ? 8 : 4)
+#define CLK_TCA0_CLKSEL(F)      ((F) == 16000000 ? 0x08 : ((F) == 8000000 || (F) == 24000000) ? 0x06 : 0x04)
+#define CLK_TCA0_TICKS_PER_US(F) ((F) / CLK_TCA0_CLK_DIV(F) / 1000000UL)
+#define CLK_TCA0_PER_1MS(F)     ((F) / CLK_TCA0_CLK_DIV(F) / 1000UL - 1)
+#define CLK_SPI0_CLK_DIV(F)     (((F) / 4 <= SPI0_SCK_MAX_HZ) ? 4 : ((F) / 8 <= SPI0_SCK_MAX_HZ) ? 8 : \
+                                 ((F) / 16 <= SPI0_SCK_MAX_HZ) ? 16 : ((F) / 32 <= SPI0_SCK_MAX_HZ) ? 32 : 64)
+#define CLK_SPI0_PRESC(F)       (CLK_SPI0_CLK_DIV(F) == 4 ? 0x00 : CLK_SPI0_CLK_DIV(F) == 8 ? 0x12 : \
+                                 CLK_SPI0_CLK_DIV(F) == 16 ? 0x02 : CLK_SPI0_CLK_DIV(F) == 32 ? 0x14 : 0x04)
+
+#if !CLK_IS_PROFILE(F_CPU)
+#error "F_CPU must be 4000000, 8000000, 16000000 or 24000000"
+#endif
+
+/* Settings at F_CPU, used by the MCC initialization */
+#define CLKCTRL_OSCHF_FREQSEL   CLK_OSCHF_FREQSEL(F_CPU)
+#define TCA0_CLKSEL             CLK_TCA0_CLKSEL(F_CPU)
+#define TCA0_TICKS_PER_US       CLK_TCA0_TICKS_PER_US(F_CPU)
+#define TCA0_PER_1MS            CLK_TCA0_PER_1MS(F_CPU)
+#define SPI0_PRESC              CLK_SPI0_PRESC(F_CPU)
+#define SPI0_SCK_HZ             (F_CPU / CLK_SPI0_CLK_DIV(F_CPU))
+
 #endif // CLOCK_CONFIG_H
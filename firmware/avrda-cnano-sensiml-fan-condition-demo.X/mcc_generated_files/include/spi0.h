@@ -35,6 +35,7 @@
 #define SPI0_BASIC_H_INCLUDED
 
 #include "../utils/compiler.h"
+#include "../config/clock_config.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
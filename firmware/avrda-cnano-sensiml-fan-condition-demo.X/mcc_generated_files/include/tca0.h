@@ -35,6 +35,7 @@
 #define TCA0_H_INCLUDED
 
 #include "../utils/compiler.h"
+#include "../config/clock_config.h"
 
 #ifdef __cplusplus
 extern "C" {
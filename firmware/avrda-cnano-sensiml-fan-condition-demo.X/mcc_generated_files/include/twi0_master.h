@@ -38,13 +38,15 @@
 #include <stdint.h>
 #include <stdio.h>
 #include "../utils/compiler.h"
+#include "../config/clock_config.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define TWI0_BAUD(F_SCL, T_RISE)    \
-    ((((((float)4000000 / (float)F_SCL)) - 10 - ((float)4000000 * T_RISE / 1000000))) / 2)
+#define TWI0_BAUD(F_SCL, T_RISE)    TWI0_BAUD_F(F_CPU, F_SCL, T_RISE)
+#define TWI0_BAUD_F(F, F_SCL, T_RISE)    \
+    ((((((float)(F) / (float)F_SCL)) - 10 - ((float)(F) * T_RISE / 1000000))) / 2)
 
 
 typedef enum {
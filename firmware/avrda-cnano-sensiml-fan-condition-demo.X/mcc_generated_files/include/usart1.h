@@ -44,8 +44,9 @@
 extern "C" {
 #endif
 
-/* Normal Mode, Baud register value */
-#define USART1_BAUD_RATE(BAUD_RATE) (((float)4000000 * 64 / (16 * (float)BAUD_RATE)) + 0.5)
+/* Normal Mode, Baud register value at F_CPU and at a CPU clock F */
+#define USART1_BAUD_RATE(BAUD_RATE) USART1_BAUD_RATE_F(F_CPU, BAUD_RATE)
+#define USART1_BAUD_RATE_F(F, BAUD_RATE) (((float)(F) * 64 / (16 * (float)BAUD_RATE)) + 0.5)
 
 /**
  * \brief Initialize USART interface
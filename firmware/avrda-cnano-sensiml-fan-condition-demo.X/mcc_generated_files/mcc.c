@@ -96,8 +96,8 @@ int8_t CLKCTRL_Initialize()
     //PLLS disabled; EXTS disabled; XOSC32KS disabled; OSC32KS disabled; OSCHFS disabled; SOSC disabled; 
     ccp_write_io((void*)&(CLKCTRL.MCLKSTATUS),0x00);
 
-    //RUNSTDBY disabled; FREQSEL 4M; AUTOTUNE disabled; 
-    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA),0x0C); 
+    //RUNSTDBY disabled; FREQSEL from F_CPU; AUTOTUNE disabled; 
+    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA),CLKCTRL_OSCHF_FREQSEL); 
 
     //LOCKEN disabled; 
     ccp_write_io((void*)&(CLKCTRL.MCLKLOCK),0x00);
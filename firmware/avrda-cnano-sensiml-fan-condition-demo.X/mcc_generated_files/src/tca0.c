@@ -165,14 +165,14 @@ int8_t TCA0_Initialize()
     //CMP2 disabled; CMP1 disabled; CMP0 disabled; OVF disabled; 
     TCA0.SINGLE.INTFLAGS = 0x00;
 
-    //Period
-    TCA0.SINGLE.PER = 0x3E7;
+    //Period; 1ms
+    TCA0.SINGLE.PER = TCA0_PER_1MS;
 
     //Temporary data for 16-bit Access
     TCA0.SINGLE.TEMP = 0x00;
 
-    //RUNSTDBY disabled; CLKSEL DIV4; ENABLE enabled; 
-    TCA0.SINGLE.CTRLA = 0x05;
+    //RUNSTDBY disabled; CLKSEL from F_CPU; ENABLE enabled; 
+    TCA0.SINGLE.CTRLA = TCA0_CLKSEL | 0x01;
 
     return 0;
 }
@@ -0,0 +1,140 @@
+/*******************************************************************************
+  Profiling Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    profile.c
+
+  Summary:
+    This file contains the run time profiling of the application
+
+  Notes:
+    - See profile.h
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "profile.h"
+#include "sml_recognition_run.h"
+#include "mcc_generated_files/mcc.h"
+#if APP_CLOCK_BOOST
+#include "clock_scaling.h"
+#endif
+
+/* Clock the section ran at; with APP_CLOCK_BOOST the main loop switches it
+ * for the passes that complete a segment only, so it is read per run */
+#if APP_CLOCK_BOOST
+#define PROFILE_HZ()        clock_scaling_get_hz()
+#else
+#define PROFILE_HZ()        F_CPU
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint64_t total_cycles;
+    uint32_t max_cycles;
+} profile_stat_t;
+
+static profile_stat_t stats[PROFILE_NUM_SLOTS];
+static uint32_t interval_start;
+
+static const char * const slot_names[PROFILE_NUM_SLOTS] = {
+    "sensor isr", "model", "output", "sleep", "wake", "decimate"
+};
+
+void profile_init(void) {
+    ENTER_CRITICAL(R);
+    memset(stats, 0, sizeof(stats));
+    interval_start = (uint32_t) read_timer_us();
+    EXIT_CRITICAL(R);
+}
+
+void profile_add(uint8_t slot, uint32_t us) {
+    profile_stat_t *stat = &stats[slot];
+    uint32_t cycles = us * (PROFILE_HZ() / 1000000UL);
+    stat->count++;
+    stat->total_us += us;
+    stat->total_cycles += cycles;
+    if (cycles > stat->max_cycles)
+        stat->max_cycles = cycles;
+}
+
+void profile_report(void) {
+    profile_stat_t s[PROFILE_NUM_SLOTS];
+    uint32_t elapsed;
+    
+    /* Take a consistent snapshot; the sensor interrupt updates its slot */
+    ENTER_CRITICAL(R);
+    memcpy(s, stats, sizeof(s));
+    elapsed = (uint32_t) read_timer_us() - interval_start;
+    EXIT_CRITICAL(R);
+    
+    for (uint8_t i=0; i < PROFILE_NUM_SLOTS; i++) {
+        printf("profile: %-10s n=%lu avg=%lu max=%lu cycles\n", slot_names[i], (unsigned long) s[i].count,
+            (unsigned long) (s[i].count ? s[i].total_cycles / s[i].count : 0UL),
+            (unsigned long) s[i].max_cycles);
+    }
+    
+    /* The model time includes the result output */
+    uint32_t busy = s[PROFILE_SNSR_ISR].total_us + s[PROFILE_MODEL].total_us + s[PROFILE_DECIMATE].total_us;
+    uint32_t samples = s[PROFILE_SNSR_ISR].count;
+#if SML_DECIMATION > 1
+    /* Front end cost per full rate sample against the sample period */
+    if (samples > 0) {
+        uint32_t front_us = s[PROFILE_SNSR_ISR].total_us + s[PROFILE_DECIMATE].total_us;
+        printf("profile: decimate %lu cycles, sensor isr + decimate %luus of %luus per input sample\n",
+            (unsigned long) (s[PROFILE_DECIMATE].total_cycles / samples),
+            (unsigned long) (front_us / samples), 1000000UL / SNSR_SAMPLE_RATE);
+    }
+#endif
+#if SML_GATE
+    uint32_t gated, classified;
+    sml_recognition_gate_stats(&gated, &classified);
+    printf("profile: segments gated %lu, classified %lu since start-up\n", (unsigned long) gated, (unsigned long) classified);
+#endif
+#if SML_CADENCE
+    uint32_t skipped, fallbacks;
+    sml_recognition_cadence_stats(&skipped, &fallbacks);
+    printf("profile: segments skipped %lu, skips cancelled by a range change %lu since start-up\n",
+        (unsigned long) skipped, (unsigned long) fallbacks);
+#endif
+    uint32_t busy_permille = busy / (elapsed / 1000U + 1);
+    uint16_t idle_permille = (busy_permille < 1000U) ? 1000U - busy_permille : 0;
+    printf("profile: idle %u.%u%% over %lums", idle_permille / 10U, idle_permille % 10U, (unsigned long) (elapsed / 1000U));
+#if APP_IDLE_SLEEP
+    /* Measured, as opposed to the idle time derived from the busy time */
+    uint32_t sleep_permille = s[PROFILE_SLEEP].total_us / (elapsed / 1000U + 1);
+    printf(", asleep %u.%u%%", (uint16_t) (sleep_permille / 10U), (uint16_t) (sleep_permille % 10U));
+#endif
+    if (busy > 0)
+        printf(", max sample rate %luHz", (unsigned long) ((uint64_t) samples * 1000000UL / busy));
+    printf("\n");
+    
+    /* Don't count the time spent reporting */
+    profile_init();
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+Profiling Interface Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+profile.h
+
+Summary:
+This file contains the API used for run time profiling of the application
+
+Notes:
+    - Compiles to nothing unless APP_PROFILE is enabled in app_config.h.
+    - Times are taken with read_timer_us(), i.e. with 1us resolution, and are
+      reported in CPU cycles.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef PROFILE_H
+#define	PROFILE_H
+#include <stdint.h>
+#include "app_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Profiled sections of the application
+enum profile_slot {
+    PROFILE_SNSR_ISR = 0,   // sensor interrupt handler
+    PROFILE_MODEL,          // sml_recognition_run* call, including result output
+    PROFILE_OUTPUT,         // result output over the UART
+    PROFILE_SLEEP,          // CPU asleep in the main loop or a delay (APP_IDLE_SLEEP)
+    PROFILE_WAKE,           // sensor interrupt to the main loop resuming from sleep
+    PROFILE_DECIMATE,       // decimator, per full rate sample (SML_DECIMATION)
+    PROFILE_NUM_SLOTS
+};
+
+#if APP_PROFILE
+#define PROFILE_START(slot)     uint32_t _profile_t0_ ## slot = (uint32_t) read_timer_us()
+#define PROFILE_END(slot)       profile_add(slot, (uint32_t) read_timer_us() - _profile_t0_ ## slot)
+#else
+#define PROFILE_START(slot)     do {} while (0)
+#define PROFILE_END(slot)       do {} while (0)
+#endif
+
+extern uint64_t read_timer_us(void);
+
+/* Reset the statistics and start a new measurement interval */
+void profile_init(void);
+
+/* Add the duration of one run of a profiled section */
+void profile_add(uint8_t slot, uint32_t us);
+
+/* Print the statistics of the current interval and start a new one */
+void profile_report(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PROFILE_H */
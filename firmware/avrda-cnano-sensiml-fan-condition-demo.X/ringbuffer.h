@@ -86,6 +86,9 @@ typedef uint16_t ringbuffer_size_t;
 #elif defined (__arm__) || defined(__XC32)
 /* SAM, PIC32C, PIC32M */
 typedef uint32_t ringbuffer_size_t;
+#elif defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+/* Host builds */
+typedef uint32_t ringbuffer_size_t;
 #else
 #pragma message("ringbuffer.h:: Unsure about architecture, assuming 32-bit accesses are atomic")
 typedef uint32_t ringbuffer_size_t;
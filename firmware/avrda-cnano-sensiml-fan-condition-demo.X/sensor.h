@@ -39,18 +39,27 @@
 #ifndef SENSOR_H
 #define	SENSOR_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "sensor_config.h"
 #if SNSR_TYPE_BMI160
     #include "bmi160.h"
 #elif SNSR_TYPE_ICM42688
     #include "Icm426xxDriver_HL.h"
+#elif SNSR_TYPE_CSV
+    #include "csv_sensor.h"
+#elif SNSR_TYPE_REPLAY
+    #include "replay_sensor.h"
 #endif
 
 #if SNSR_TYPE_BMI160
     #define SNSR_STATUS_OK BMI160_OK
 #elif SNSR_TYPE_ICM42688
     #define SNSR_STATUS_OK INV_ERROR_SUCCESS
+#elif SNSR_TYPE_CSV
+    #define SNSR_STATUS_OK CSV_SENSOR_OK
+#elif SNSR_TYPE_REPLAY
+    #define SNSR_STATUS_OK REPLAY_SENSOR_OK
 #endif
 
 // Buffer size in bytes for TX with IMU device
@@ -66,6 +75,10 @@ struct sensor_device_t {
 #elif SNSR_TYPE_ICM42688
     struct inv_icm426xx device;
     struct inv_icm426xx_serif serif;    
+#elif SNSR_TYPE_CSV
+    struct csv_sensor_dev device;
+#elif SNSR_TYPE_REPLAY
+    struct replay_sensor_dev device;
 #endif
     volatile int status;
 };
@@ -82,6 +95,37 @@ int sensor_set_config(struct sensor_device_t *sensor);
 
 int sensor_read(struct sensor_device_t *sensor, snsr_data_t *ptr);
 
+#ifdef sensor_read_fifo
+// Drain the sensor FIFO into at most nframes sample frames at ptr, which also
+// serve as the read buffer; returns the number of frames written, or a
+// negative value on error
+int sensor_read_fifo(struct sensor_device_t *sensor, snsr_data_t *ptr, uint16_t nframes);
+
+// Discard the samples queued in the sensor FIFO
+int sensor_reset_fifo(struct sensor_device_t *sensor);
+#endif
+
+#ifdef sensor_set_wom
+// enable: put the IMU in low power, accel only wake on motion mode, with the
+// motion interrupt on the sensor interrupt pin in place of data ready
+// !enable: leave wake on motion mode and restore the sensor_set_config()
+// configuration
+int sensor_set_wom(struct sensor_device_t *sensor, bool enable);
+#endif
+
+// Events flagged by the IMU motion engines
+#define SNSR_EVENT_TAP      (1U << 0)
+#define SNSR_EVENT_SHAKE    (1U << 1)
+
+#ifdef sensor_read_events
+// Hand over the events of the motion engines enabled by sensor_set_config()
+// with SNSR_EVENTS; events returns the SNSR_EVENT_* flags raised since the
+// last call. Called after each sensor read with the number of frames it
+// read; the IMU holds the status, which is only read once SNSR_EVENT_POLL
+// frames have been read since the last time
+int sensor_read_events(struct sensor_device_t *sensor, uint8_t nframes, uint8_t *events);
+#endif
+
 #ifdef	__cplusplus
 }
 #endif
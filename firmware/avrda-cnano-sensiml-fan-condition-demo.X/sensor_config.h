@@ -41,7 +41,7 @@
 // *****************************************************************************
 
 /* IMU Sensor type defined at a project level */
-#if !defined(SNSR_TYPE_BMI160) && !defined(SNSR_TYPE_ICM42688)
+#if !defined(SNSR_TYPE_BMI160) && !defined(SNSR_TYPE_ICM42688) && !defined(SNSR_TYPE_CSV) && !defined(SNSR_TYPE_REPLAY)
 #define SNSR_TYPE_BMI160    1
 #define SNSR_TYPE_ICM42688  0
 #endif
@@ -60,10 +60,41 @@
     #define sensor_init        bmi160_sensor_init
     #define sensor_set_config  bmi160_sensor_set_config
     #define sensor_read        bmi160_sensor_read
+    #define sensor_set_wom     bmi160_sensor_set_wom
+    #define sensor_read_events bmi160_sensor_read_events
 #elif SNSR_TYPE_ICM42688
     #define sensor_init        icm42688_sensor_init
     #define sensor_set_config  icm42688_sensor_set_config
     #define sensor_read        icm42688_sensor_read
+    #define sensor_read_fifo   icm42688_sensor_read_fifo
+    #define sensor_reset_fifo  icm42688_sensor_reset_fifo
+    #define sensor_set_wom     icm42688_sensor_set_wom
+    #define sensor_read_events icm42688_sensor_read_events
+#elif SNSR_TYPE_CSV
+    #define sensor_init        csv_sensor_init
+    #define sensor_set_config  csv_sensor_set_config
+    #define sensor_read        csv_sensor_read
+#elif SNSR_TYPE_REPLAY
+    #define sensor_init        replay_sensor_init
+    #define sensor_set_config  replay_sensor_set_config
+    #define sensor_read        replay_sensor_read
+#endif
+
+// Index of the first/last axis (SNSR_AXIS_* bit position) set in an axis mask
+#define SNSR_AXIS_FIRST_OF(m)   (((m) & 0x01) ? 0 : ((m) & 0x02) ? 1 : ((m) & 0x04) ? 2 \
+                                : ((m) & 0x08) ? 3 : ((m) & 0x10) ? 4 : 5)
+#define SNSR_AXIS_LAST_OF(m)    (((m) & 0x20) ? 5 : ((m) & 0x10) ? 4 : ((m) & 0x08) ? 3 \
+                                : ((m) & 0x04) ? 2 : ((m) & 0x02) ? 1 : 0)
+#define SNSR_AXIS_FIRST         SNSR_AXIS_FIRST_OF(SNSR_AXIS_MASK)
+#define SNSR_AXIS_LAST          SNSR_AXIS_LAST_OF(SNSR_AXIS_MASK)
+// No unused axis between the first and last axis in use
+#define SNSR_AXIS_CONTIGUOUS    (SNSR_NUM_AXES == SNSR_AXIS_LAST - SNSR_AXIS_FIRST + 1)
+
+// Little endian 16 bit register data can be read straight into a sample frame
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define SNSR_CPU_LITTLE_ENDIAN  1
+#else
+#define SNSR_CPU_LITTLE_ENDIAN  0
 #endif
 
 #ifdef	__cplusplus
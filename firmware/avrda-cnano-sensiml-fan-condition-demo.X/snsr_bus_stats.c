@@ -0,0 +1,86 @@
+/*******************************************************************************
+  Sensor Bus Statistics Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    snsr_bus_stats.c
+
+  Summary:
+    This file contains the sensor bus traffic counters
+
+  Notes:
+    - See snsr_bus_stats.h
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "snsr_bus_stats.h"
+#include "mcc_generated_files/mcc.h"
+
+#if SNSR_BUS_STATS
+static snsr_bus_stats_t stats;
+
+void snsr_bus_stats_add(bool write, uint16_t tx_bytes, uint16_t rx_bytes, uint16_t transactions, uint32_t busy_us) {
+    /* Calls from the main loop may be interrupted by the sensor interrupt */
+    ENTER_CRITICAL(R);
+    if (write)
+        stats.write_calls++;
+    else
+        stats.read_calls++;
+    stats.tx_bytes += tx_bytes;
+    stats.rx_bytes += rx_bytes;
+    stats.transactions += transactions;
+    stats.busy_us += busy_us;
+    EXIT_CRITICAL(R);
+}
+
+void snsr_bus_stats_error(bool nack) {
+    ENTER_CRITICAL(R);
+    if (nack)
+        stats.nacks++;
+    else
+        stats.errors++;
+    EXIT_CRITICAL(R);
+}
+
+void snsr_bus_stats_take(snsr_bus_stats_t *s) {
+    ENTER_CRITICAL(R);
+    memcpy(s, &stats, sizeof(stats));
+    memset(&stats, 0, sizeof(stats));
+    EXIT_CRITICAL(R);
+}
+
+void snsr_bus_stats_report(void) {
+    snsr_bus_stats_t s;
+    
+    snsr_bus_stats_take(&s);
+    printf("bus: %s reads=%lu writes=%lu transactions=%lu\n", SNSR_NAME,
+        (unsigned long) s.read_calls, (unsigned long) s.write_calls, (unsigned long) s.transactions);
+    printf("bus: tx=%luB rx=%luB busy=%luus errors=%u nacks=%u\n", (unsigned long) s.tx_bytes,
+        (unsigned long) s.rx_bytes, (unsigned long) s.busy_us, s.errors, s.nacks);
+}
+#endif
@@ -0,0 +1,98 @@
+/*******************************************************************************
+Sensor Bus Statistics Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+snsr_bus_stats.h
+
+Summary:
+This file contains the API used to count the SPI/I2C traffic of the sensor
+drivers
+
+Notes:
+    - Compiles to nothing unless SNSR_BUS_STATS is enabled in app_config.h.
+    - The counters are updated by the serial comms functions of the sensor
+      driver interface (app_config/<sensor>/<sensor>_sensor.c), from both the
+      main loop and the sensor interrupt. The busy time is taken with
+      snsr_read_timer_us() (see sensor.h).
+    - Byte counts are bytes on the wire: register addresses and, on I2C, the
+      device address bytes are included.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef SNSR_BUS_STATS_H
+#define	SNSR_BUS_STATS_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t read_calls;
+    uint32_t write_calls;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t transactions;  // CS assert to release (SPI), START to STOP (I2C)
+    uint32_t busy_us;       // time spent waiting for transfers to complete
+    uint16_t errors;
+    uint16_t nacks;
+} snsr_bus_stats_t;
+
+#if SNSR_BUS_STATS
+#define SNSR_BUS_STATS_START()  uint32_t _snsr_bus_t0 = (uint32_t) snsr_read_timer_us()
+#define SNSR_BUS_STATS_READ(ntx, nrx, ntrans) \
+    snsr_bus_stats_add(false, ntx, nrx, ntrans, (uint32_t) snsr_read_timer_us() - _snsr_bus_t0)
+#define SNSR_BUS_STATS_WRITE(ntx, ntrans) \
+    snsr_bus_stats_add(true, ntx, 0, ntrans, (uint32_t) snsr_read_timer_us() - _snsr_bus_t0)
+#define SNSR_BUS_STATS_ERROR()  snsr_bus_stats_error(false)
+#define SNSR_BUS_STATS_NACK()   snsr_bus_stats_error(true)
+#else
+#define SNSR_BUS_STATS_START()  do {} while (0)
+#define SNSR_BUS_STATS_READ(ntx, nrx, ntrans) do {} while (0)
+#define SNSR_BUS_STATS_WRITE(ntx, ntrans) do {} while (0)
+#define SNSR_BUS_STATS_ERROR()  do {} while (0)
+#define SNSR_BUS_STATS_NACK()   do {} while (0)
+#endif
+
+/* Add one read or write call of the sensor driver */
+void snsr_bus_stats_add(bool write, uint16_t tx_bytes, uint16_t rx_bytes, uint16_t transactions, uint32_t busy_us);
+
+/* Count a failed transfer or an address NACK */
+void snsr_bus_stats_error(bool nack);
+
+/* Copy the counters into stats and reset them */
+void snsr_bus_stats_take(snsr_bus_stats_t *stats);
+
+/* Print the counters and reset them */
+void snsr_bus_stats_report(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SNSR_BUS_STATS_H */
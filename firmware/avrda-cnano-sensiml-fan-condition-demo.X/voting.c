@@ -0,0 +1,95 @@
+/*******************************************************************************
+  Classification Voting Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    voting.c
+
+  Summary:
+    This file contains the majority voting scheme used for post processing of
+    the model classifications
+
+  Notes:
+    - Not thread safe; call from the thread running the model only.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "voting.h"
+
+static int clsid = 1;
+static uint8_t nvotes = NUM_VOTES;
+static int votehist[VOTING_MAX_VOTES] = {1};
+static int votecounts[NUM_CLASSES] = {0};
+
+void voting_reset(void) {
+    clsid = 1;
+    memset(votehist, 0, sizeof(votehist));
+    memset(votecounts, 0, sizeof(votecounts));
+    votehist[0] = 1;
+}
+
+int voting_update(int classification) {
+    /* Update the voting counts */
+    votecounts[votehist[0]]--;
+    for (int i=1; i < nvotes; i++)
+        votehist[i-1] = votehist[i];
+    votehist[nvotes-1] = classification;
+    votecounts[classification]++;
+    
+    /* If there's a new state that is consistently classified as the same class, update the class ID */
+    if (classification == clsid)
+        return -1;
+
+    /* Get the class with the most votes */
+    int maxval = -1, maxcls = -1;
+    for (int i=0; i < NUM_CLASSES; i++) {
+        if (votecounts[i] > maxval) {
+            maxval = votecounts[i];
+            maxcls = i;
+        }
+    }
+
+    if (maxval >= (nvotes + 1) / 2 && maxcls != clsid) {
+        clsid = maxcls;
+        return clsid;
+    }
+    
+    return -1;
+}
+
+int voting_get_class(void) {
+    return clsid;
+}
+
+void voting_set_votes(uint8_t votes) {
+    if (votes < 1)
+        votes = 1;
+    else if (votes > VOTING_MAX_VOTES)
+        votes = VOTING_MAX_VOTES;
+    nvotes = votes;
+    voting_reset();
+}
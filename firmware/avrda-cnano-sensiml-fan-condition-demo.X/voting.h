@@ -0,0 +1,80 @@
+/*******************************************************************************
+Classification Voting Interface Header File
+
+Company:
+Microchip Technology Inc.
+
+File Name:
+voting.h
+
+Summary:
+This file contains the majority voting API used for post processing of the
+model classifications
+
+Notes:
+    - Not thread safe; call from the thread running the model only.
+ *******************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2020 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *******************************************************************************/
+#ifndef VOTING_H
+#define	VOTING_H
+#include <stdint.h>
+
+// Number of classes output by the model (class IDs 0 to NUM_CLASSES-1)
+#define NUM_CLASSES     7U
+
+// Number of most recent classifications taking part in the vote
+#define NUM_VOTES       3U
+
+// Number of votes a class needs to be selected
+#define MAJORITY_VOTES  ((NUM_VOTES + 1) / 2U)
+
+// Upper limit for the number of votes set at run time with voting_set_votes()
+#ifndef VOTING_MAX_VOTES
+#define VOTING_MAX_VOTES NUM_VOTES
+#endif
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Reset the vote history */
+void voting_reset(void);
+
+/* Add a new classification to the vote history
+ * Returns the newly selected class ID when the vote changed the current class,
+ * -1 otherwise */
+int voting_update(int classification);
+
+/* Get the currently selected class ID */
+int voting_get_class(void);
+
+/* Set the number of most recent classifications taking part in the vote
+ * (1 to VOTING_MAX_VOTES) and reset the vote history */
+void voting_set_votes(uint8_t votes);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* VOTING_H */
@@ -218,6 +218,19 @@ static void default_param_settg(struct bmi160_dev *dev);
  */
 static int8_t null_ptr_check(const struct bmi160_dev *dev);
 
+#if BMI160_REG_CACHE
+
+/*!
+ * @brief This API updates the register shadow cache after a register write
+ *
+ * @param[in] reg_addr    : Register address written
+ * @param[in] data        : Data written
+ * @param[in] len         : No of bytes written
+ * @param[in] dev         : Structure instance of bmi160_dev.
+ */
+static void reg_cache_write(uint8_t reg_addr, const uint8_t *data, uint16_t len, const struct bmi160_dev *dev);
+#endif
+
 /*!
  * @brief This API set the accel configuration.
  *
@@ -1379,6 +1392,14 @@ int8_t bmi160_get_regs(uint8_t reg_addr, uint8_t *data, uint16_t len, const stru
     {
         rslt = BMI160_READ_WRITE_LENGHT_INVALID;
     }
+#if BMI160_REG_CACHE
+    else if (dev->reg_cache_valid && (reg_addr >= BMI160_REG_CACHE_START) &&
+             ((reg_addr + len) <= (BMI160_REG_CACHE_END + 1)))
+    {
+        /* Served from the shadow cache */
+        memcpy(data, &dev->reg_cache[reg_addr - BMI160_REG_CACHE_START], len);
+    }
+#endif
     else
     {
         /* Configuring reg_addr for SPI Interface */
@@ -1437,7 +1458,14 @@ int8_t bmi160_set_regs(uint8_t reg_addr, uint8_t *data, uint16_t len, const stru
             rslt = dev->write(dev->id, reg_addr, data, len);
 
             /* Kindly refer bmi160 data sheet section 3.2.4 */
-            dev->delay_ms(1);
+            if (dev->delay_us != NULL)
+            {
+                dev->delay_us(BMI160_NORMAL_WRITE_DELAY_US);
+            }
+            else
+            {
+                dev->delay_ms(1);
+            }
 
         }
         else
@@ -1453,7 +1481,11 @@ int8_t bmi160_set_regs(uint8_t reg_addr, uint8_t *data, uint16_t len, const stru
                 dev->delay_ms(1);
 
             }
+            reg_addr -= count;
         }
+#if BMI160_REG_CACHE
+        reg_cache_write(reg_addr, (rslt == BMI160_OK) ? data : NULL, len, dev);
+#endif
         if (rslt != BMI160_OK)
         {
             rslt = BMI160_E_COM_FAIL;
@@ -1496,6 +1528,10 @@ int8_t bmi160_init(struct bmi160_dev *dev)
 
     if (rslt == BMI160_OK)
     {
+#if BMI160_REG_CACHE
+        dev->reg_cache_valid = 0;
+#endif
+
         /* Assign chip id as zero */
         dev->chip_id = 0;
 
@@ -1514,6 +1550,14 @@ int8_t bmi160_init(struct bmi160_dev *dev)
 
             /* Soft reset */
             rslt = bmi160_soft_reset(dev);
+#if BMI160_REG_CACHE
+            if (rslt == BMI160_OK)
+            {
+                /* Fill the shadow cache with the register values after reset */
+                rslt = bmi160_get_regs(BMI160_REG_CACHE_START, dev->reg_cache, BMI160_REG_CACHE_LEN, dev);
+                dev->reg_cache_valid = (rslt == BMI160_OK);
+            }
+#endif
         }
         else
         {
@@ -1542,6 +1586,9 @@ int8_t bmi160_soft_reset(struct bmi160_dev *dev)
     {
         /* Reset the device */
         rslt = bmi160_set_regs(BMI160_COMMAND_REG_ADDR, &data, 1, dev);
+#if BMI160_REG_CACHE
+        dev->reg_cache_valid = 0;
+#endif
         dev->delay_ms(BMI160_SOFT_RESET_DELAY_MS);
         if ((rslt == BMI160_OK) && (dev->interface == BMI160_SPI_INTF))
         {
@@ -3089,6 +3136,38 @@ static int8_t set_intr_pin_config(const struct bmi160_int_settg *int_config, con
     return rslt;
 }
 
+#if BMI160_REG_CACHE
+
+/*!
+ * @brief This API updates the register shadow cache after a register write;
+ * data is NULL if the write failed, which invalidates the cache
+ */
+static void reg_cache_write(uint8_t reg_addr, const uint8_t *data, uint16_t len, const struct bmi160_dev *dev)
+{
+    /* The API passes bmi160_dev as const; the shadow cache is the only
+     * member updated through it */
+    struct bmi160_dev *cache_dev = (struct bmi160_dev *)dev;
+    uint16_t indx;
+
+    if (!cache_dev->reg_cache_valid)
+    {
+        return;
+    }
+    if (data == NULL)
+    {
+        cache_dev->reg_cache_valid = 0;
+        return;
+    }
+    for (indx = 0; indx < len; indx++, reg_addr++)
+    {
+        if ((reg_addr >= BMI160_REG_CACHE_START) && (reg_addr <= BMI160_REG_CACHE_END))
+        {
+            cache_dev->reg_cache[reg_addr - BMI160_REG_CACHE_START] = data[indx];
+        }
+    }
+}
+#endif
+
 /*!
  * @brief This internal API is used to validate the device structure pointer for
  * null conditions.
@@ -339,6 +339,19 @@
 #define BMI160_SPI_COMM_TEST_ADDR            UINT8_C(0x7F)
 #define BMI160_INTL_PULLUP_CONF_ADDR         UINT8_C(0x85)
 
+/** Idle time needed between register writes in normal mode (data sheet
+ * section 3.2.4) */
+#define BMI160_NORMAL_WRITE_DELAY_US         UINT8_C(2)
+
+/** Register shadow cache: configuration registers that only change when
+ * written are served from bmi160_dev instead of the bus */
+#ifndef BMI160_REG_CACHE
+#define BMI160_REG_CACHE                     1
+#endif
+#define BMI160_REG_CACHE_START               BMI160_ACCEL_CONFIG_ADDR
+#define BMI160_REG_CACHE_END                 BMI160_IF_CONF_ADDR
+#define BMI160_REG_CACHE_LEN                 (BMI160_REG_CACHE_END - BMI160_REG_CACHE_START + 1)
+
 /** Error code definitions */
 #define BMI160_OK                            INT8_C(0)
 #define BMI160_E_NULL_PTR                    INT8_C(-1)
@@ -1718,11 +1731,25 @@ struct bmi160_dev
     /*!  Delay function pointer */
     bmi160_delay_fptr_t delay_ms;
 
+    /*! Optional microsecond delay; when set, it replaces the 1ms delay after
+     * normal mode writes with BMI160_NORMAL_WRITE_DELAY_US */
+    bmi160_delay_fptr_t delay_us;
+
     /*! User set read/write length */
     uint16_t read_write_len;
 
     /*! For switching from I2C to SPI */
     uint8_t dummy_byte;
+
+#if BMI160_REG_CACHE
+    /*! Shadow of registers BMI160_REG_CACHE_START..BMI160_REG_CACHE_END,
+     * filled by bmi160_init, updated by bmi160_set_regs and invalidated by
+     * bmi160_soft_reset */
+    uint8_t reg_cache[BMI160_REG_CACHE_LEN];
+
+    /*! Non-zero while reg_cache matches the device */
+    uint8_t reg_cache_valid;
+#endif
 };
 
 #endif /* BMI160_DEFS_H_ */
@@ -0,0 +1,39 @@
+/*******************************************************************************
+  Host Benchmark Timer Header File
+
+  File Name:
+    bench_timer.h
+
+  Summary:
+    Monotonic timer and result sink shared by the host benchmarks
+
+  Description:
+    Each benchmark defines BENCH_ITERS, the number of timed repetitions, and
+    divides the elapsed bench_timer_read() difference by it. Results are in
+    host nanoseconds (BENCH_UNIT); the benchmarks have no target build.
+
+    Kernel results are accumulated into bench_sink so that the compiler does
+    not drop the timed calls.
+ *******************************************************************************/
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifndef BENCH_ITERS
+#error "Define BENCH_ITERS before including bench_timer.h"
+#endif
+
+typedef uint64_t bench_time_t;
+#define BENCH_UNIT  "ns"
+
+static volatile int32_t bench_sink;
+
+static inline bench_time_t bench_timer_read(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (bench_time_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#endif /* BENCH_TIMER_H */
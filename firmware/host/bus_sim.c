@@ -0,0 +1,263 @@
+/*******************************************************************************
+  Simulated Sensor Bus Source File
+
+  File Name:
+    bus_sim.c
+
+  Summary:
+    Host implementation of the MCC SPI0, TWI0 master and chip select
+    functions, routed to a device model with bus transaction accounting
+
+  Notes:
+    - See bus_sim.h
+    - The TWI0 functions follow the callback protocol of the MCC driver
+      (twi0_master.c): after the buffer is sent or filled, the data complete
+      callback selects STOP, RESTART_READ or RESTART_WRITE; on an address NACK
+      the address NACK callback does. The whole operation runs synchronously
+      inside I2C0_MasterOperation(), so I2C0_Close() never reports busy.
+ *******************************************************************************/
+#include <stddef.h>
+#include "mcc_generated_files/mcc.h"
+
+// Give up on an operation after this many address NACK retries
+#define BUS_SIM_MAX_NACK_RETRIES    8
+
+static const struct bus_sim_spi_dev *spi_dev = NULL;
+static const struct bus_sim_i2c_dev *i2c_dev = NULL;
+static struct bus_sim_stats stats;
+static uint64_t time_us = 0;
+static bool cs_asserted = false;
+
+static struct {
+    bool in_use;
+    twi0_address_t address;
+    uint8_t *buffer;
+    size_t size;
+    twi0_callback_t data_complete;
+    void *data_complete_payload;
+    twi0_callback_t address_nack;
+    void *address_nack_payload;
+    twi0_error_t error;
+} i2c;
+
+void bus_sim_attach_spi(const struct bus_sim_spi_dev *dev) {
+    spi_dev = dev;
+    cs_asserted = false;
+}
+
+void bus_sim_attach_i2c(const struct bus_sim_i2c_dev *dev) {
+    i2c_dev = dev;
+    i2c.in_use = false;
+}
+
+void bus_sim_reset_stats(void) {
+    stats = (struct bus_sim_stats) {0};
+}
+
+void bus_sim_get_stats(struct bus_sim_stats *s) {
+    *s = stats;
+}
+
+double bus_sim_bus_time_us(const struct bus_sim_stats *s) {
+    double spi_bits = 0, i2c_bits = 0;
+
+    if (s->cs_events) {
+        spi_bits = 8.0 * (s->tx_bytes + s->rx_bytes);
+    }
+    else {
+        /* 9 clocks per byte including the ACK, one per START/RESTART/STOP */
+        i2c_bits = 9.0 * (s->tx_bytes + s->rx_bytes) + s->starts + s->restarts + s->stops;
+    }
+    return 1e6 * (spi_bits / BUS_SIM_SPI_HZ + i2c_bits / BUS_SIM_I2C_HZ);
+}
+
+void bus_sim_advance_us(uint64_t us) {
+    time_us += us;
+}
+
+uint64_t read_timer_us(void) {
+    return time_us;
+}
+
+uint64_t read_timer_ms(void) {
+    return time_us / 1000;
+}
+
+void sleep_us(uint32_t us) {
+    time_us += us;
+}
+
+void sleep_ms(uint32_t ms) {
+    time_us += 1000ULL * ms;
+}
+
+// *****************************************************************************
+// Section: SPI0 and chip select
+// *****************************************************************************
+void MIKRO1_CS_SetLow(void) {
+    if (cs_asserted)
+        return;
+    cs_asserted = true;
+    stats.cs_events++;
+    if (spi_dev != NULL)
+        spi_dev->select(true);
+}
+
+void MIKRO1_CS_SetHigh(void) {
+    if (!cs_asserted)
+        return;
+    cs_asserted = false;
+    stats.transactions++;
+    if (spi_dev != NULL)
+        spi_dev->select(false);
+}
+
+static uint8_t SPI0_Exchange(uint8_t data) {
+    if (spi_dev == NULL || !cs_asserted)
+        return 0xFF;
+    return spi_dev->exchange(data);
+}
+
+uint8_t SPI0_ExchangeByte(uint8_t data) {
+    stats.tx_bytes++;
+    return SPI0_Exchange(data);
+}
+
+void SPI0_ExchangeBlock(void *block, size_t size) {
+    uint8_t *b = block;
+    while (size--) {
+        *b = SPI0_ExchangeByte(*b);
+        b++;
+    }
+}
+
+void SPI0_WriteBlock(void *block, size_t size) {
+    uint8_t *b = block;
+    while (size--)
+        SPI0_ExchangeByte(*b++);
+}
+
+void SPI0_ReadBlock(void *block, size_t size) {
+    uint8_t *b = block;
+    while (size--) {
+        /* Counted as received; the dummy byte clocked out carries no data */
+        stats.rx_bytes++;
+        *b++ = SPI0_Exchange(0);
+    }
+}
+
+// *****************************************************************************
+// Section: TWI0 master
+// *****************************************************************************
+twi0_operations_t I2C0_SetReturnStopCallback(void *funPtr) {
+    return I2C0_STOP;
+}
+
+twi0_operations_t I2C0_SetReturnResetCallback(void *funPtr) {
+    return I2C0_RESET_LINK;
+}
+
+twi0_operations_t I2C0_SetRestartWriteCallback(void *funPtr) {
+    return I2C0_RESTART_WRITE;
+}
+
+twi0_operations_t I2C0_SetRestartReadCallback(void *funPtr) {
+    return I2C0_RESTART_READ;
+}
+
+twi0_error_t I2C0_Open(twi0_address_t address) {
+    if (i2c.in_use)
+        return I2C0_BUSY;
+
+    i2c.in_use = true;
+    i2c.address = address;
+    i2c.buffer = NULL;
+    i2c.size = 0;
+    i2c.error = I2C0_NOERR;
+    i2c.data_complete = I2C0_SetReturnStopCallback;
+    i2c.data_complete_payload = NULL;
+    i2c.address_nack = I2C0_SetReturnStopCallback;
+    i2c.address_nack_payload = NULL;
+    return I2C0_NOERR;
+}
+
+twi0_error_t I2C0_Close(void) {
+    if (!i2c.in_use)
+        return I2C0_FAIL;
+    i2c.in_use = false;
+    return i2c.error;
+}
+
+void I2C0_SetBuffer(void *buffer, size_t bufferSize) {
+    i2c.buffer = buffer;
+    i2c.size = bufferSize;
+}
+
+void I2C0_SetDataCompleteCallback(twi0_callback_t cb, void *funPtr) {
+    i2c.data_complete = cb;
+    i2c.data_complete_payload = funPtr;
+}
+
+void I2C0_SetAddressNackCallback(twi0_callback_t cb, void *funPtr) {
+    i2c.address_nack = cb;
+    i2c.address_nack_payload = funPtr;
+}
+
+static void I2C0_Stop(void) {
+    stats.stops++;
+    stats.transactions++;
+    if (i2c_dev != NULL)
+        i2c_dev->stop();
+}
+
+twi0_error_t I2C0_MasterOperation(bool read) {
+    twi0_operations_t op;
+    unsigned retries = 0;
+
+    if (!i2c.in_use)
+        return I2C0_FAIL;
+
+    stats.starts++;
+    while (1) {
+        /* Address phase */
+        stats.tx_bytes++;
+        if (i2c_dev == NULL || i2c_dev->address != i2c.address || !i2c_dev->start(read)) {
+            stats.nacks++;
+            op = i2c.address_nack(i2c.address_nack_payload);
+            if (op == I2C0_STOP || op == I2C0_RESET_LINK || ++retries > BUS_SIM_MAX_NACK_RETRIES) {
+                I2C0_Stop();
+                i2c.error = I2C0_FAIL;
+                return I2C0_FAIL;
+            }
+        }
+        else {
+            /* Data phase */
+            for (size_t i=0; i < i2c.size; i++) {
+                if (read) {
+                    stats.rx_bytes++;
+                    i2c.buffer[i] = i2c_dev->read();
+                }
+                else {
+                    stats.tx_bytes++;
+                    i2c_dev->write(i2c.buffer[i]);
+                }
+            }
+            op = i2c.data_complete(i2c.data_complete_payload);
+        }
+
+        switch (op) {
+            case I2C0_RESTART_READ:
+            case I2C0_RESTART_WRITE:
+                stats.restarts++;
+                read = (op == I2C0_RESTART_READ);
+                break;
+            case I2C0_CONTINUE:
+                /* Not used by the sensor drivers; treat like STOP */
+            case I2C0_STOP:
+            case I2C0_RESET_LINK:
+            default:
+                I2C0_Stop();
+                return i2c.error;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+  Simulated Sensor Bus Header File
+
+  File Name:
+    bus_sim.h
+
+  Summary:
+    Host implementation of the SPI0, I2C0 (TWI0) and chip select functions
+    used by the sensor drivers, with bus transaction accounting
+
+  Description:
+    The sensor wrappers in app_config/ talk to the hardware only through the
+    MCC SPI0_*, I2C0_* and MIKRO1_CS_* functions. On host builds these are
+    provided here (see mcc_shim/mcc_generated_files/mcc.h) and routed to a
+    register level device model, so that the vendor drivers run unmodified.
+
+    Every bus access is counted:
+      - transactions: CS assert to release on SPI, START to STOP on I2C
+      - bytes: bytes clocked out (tx) and in (rx), including register
+        addresses and, on I2C, address bytes
+      - CS events: CS asserts (SPI)
+      - start/restart/stop conditions and address NACKs (I2C)
+    and the time the transfers would occupy the bus at BUS_SIM_SPI_HZ and
+    BUS_SIM_I2C_HZ is estimated from the counts.
+
+    Time is simulated: read_timer_us() returns a virtual clock advanced by
+    the sleep functions and bus_sim_advance_us(), so driver delays cost
+    nothing to run but still show up in the reported elapsed time.
+ *******************************************************************************/
+#ifndef BUS_SIM_H
+#define BUS_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mcc_generated_files/config/clock_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bus clocks used for the bus time estimate; defaults match the MCC setup
+// (SPI0 SCK derived from F_CPU in clock_config.h, TWI0 at 100kHz)
+#ifndef BUS_SIM_SPI_HZ
+#define BUS_SIM_SPI_HZ  SPI0_SCK_HZ
+#endif
+#ifndef BUS_SIM_I2C_HZ
+#define BUS_SIM_I2C_HZ  100000UL
+#endif
+
+// SPI device model: CS changes and full duplex byte exchange
+struct bus_sim_spi_dev {
+    void (*select)(bool asserted);
+    uint8_t (*exchange)(uint8_t mosi);
+};
+
+// I2C device model: address phase (returns true on ACK), data bytes, stop
+struct bus_sim_i2c_dev {
+    uint8_t address;
+    bool (*start)(bool read);
+    void (*write)(uint8_t data);
+    uint8_t (*read)(void);
+    void (*stop)(void);
+};
+
+struct bus_sim_stats {
+    uint32_t transactions;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t cs_events;
+    uint32_t starts;
+    uint32_t restarts;
+    uint32_t stops;
+    uint32_t nacks;
+};
+
+void bus_sim_attach_spi(const struct bus_sim_spi_dev *dev);
+
+void bus_sim_attach_i2c(const struct bus_sim_i2c_dev *dev);
+
+void bus_sim_reset_stats(void);
+
+void bus_sim_get_stats(struct bus_sim_stats *stats);
+
+// Estimated bus occupancy of the transfers counted in stats, in us
+double bus_sim_bus_time_us(const struct bus_sim_stats *stats);
+
+void bus_sim_advance_us(uint64_t us);
+
+uint64_t read_timer_us(void);
+
+uint64_t read_timer_ms(void);
+
+void sleep_us(uint32_t us);
+
+void sleep_ms(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUS_SIM_H */
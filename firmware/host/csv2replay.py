@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Convert an IMU recording in CSV format to the replay_data.h table used by
+the replay sensor (SNSR_TYPE_REPLAY).
+
+Columns are matched by header name (AccelerometerX..GyroscopeZ, or
+ax/ay/az/gx/gy/gz); files without a recognized header are read as AX, AY, AZ,
+GX, GY, GZ from the first six columns. Missing axes are stored as zero.
+
+usage: csv2replay.py [--start N] [--count N] [-o replay_data.h] file.csv
+"""
+import argparse
+import csv
+import os
+import re
+import sys
+
+AXIS_NAMES = [
+    ("accelerometerx", "ax", "accx", "accelx"),
+    ("accelerometery", "ay", "accy", "accely"),
+    ("accelerometerz", "az", "accz", "accelz"),
+    ("gyroscopex", "gx", "gyrox", "gyrx"),
+    ("gyroscopey", "gy", "gyroy", "gyry"),
+    ("gyroscopez", "gz", "gyroz", "gyrz"),
+]
+
+DEFAULT_OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
+                              "avrda-cnano-sensiml-fan-condition-demo.X",
+                              "app_config", "replay", "replay_data.h")
+
+
+def is_number(field):
+    try:
+        int(float(field))
+        return True
+    except ValueError:
+        return False
+
+
+def read_samples(path):
+    with open(path, newline="") as f:
+        rows = [row for row in csv.reader(f) if row]
+    if not rows:
+        sys.exit(f"{path}: empty file")
+
+    columns = list(range(6))
+    if not is_number(rows[0][0]):
+        header = [re.sub(r"[^0-9a-z]", "", h.lower()) for h in rows.pop(0)]
+        columns = [next((header.index(n) for n in names if n in header), None) for names in AXIS_NAMES]
+        if all(c is None for c in columns):
+            sys.exit(f"{path}: no IMU axis columns found")
+
+    def value(row, c):
+        if c is None or c >= len(row):
+            return 0
+        return max(-32768, min(32767, int(float(row[c]))))
+
+    return [[value(row, c) for c in columns] for row in rows]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("csv")
+    parser.add_argument("--start", type=int, default=0, help="first sample to replay")
+    parser.add_argument("--count", type=int, default=1000, help="number of samples to replay")
+    parser.add_argument("-o", "--output", default=DEFAULT_OUTPUT)
+    args = parser.parse_args()
+
+    samples = read_samples(args.csv)[args.start:args.start + args.count]
+    if not samples:
+        sys.exit(f"{args.csv}: no samples in the requested range")
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("/* Generated by host/csv2replay.py; do not edit\n")
+        f.write(f" * Source: {os.path.basename(args.csv)}, samples {args.start} to {args.start + len(samples) - 1}\n")
+        f.write(" * Axis order: AX, AY, AZ, GX, GY, GZ */\n")
+        f.write("#ifndef REPLAY_DATA_H\n#define REPLAY_DATA_H\n\n#include <stdint.h>\n\n")
+        f.write(f"#define REPLAY_DATA_LEN {len(samples)}U\n\n")
+        f.write("static const int16_t replay_data[REPLAY_DATA_LEN][6] = {\n")
+        for s in samples:
+            f.write("    {" + ", ".join(f"{v:6d}" for v in s) + "},\n")
+        f.write("};\n\n#endif /* REPLAY_DATA_H */\n")
+    print(f"wrote {len(samples)} samples to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
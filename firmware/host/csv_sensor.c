@@ -0,0 +1,148 @@
+/*******************************************************************************
+  CSV Replay Sensor Source File
+
+  File Name:
+    csv_sensor.c
+
+  Summary:
+    This file implements a sensor driver that replays IMU recordings stored as
+    CSV files for host builds
+
+  Notes:
+    - See csv_sensor.h
+ *******************************************************************************/
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sensor.h"
+
+#define CSV_SENSOR_MAX_COLUMNS  32
+
+// Header names accepted for each axis, compared in lower case with
+// non-alphanumeric characters removed
+static const char * const axis_names[CSV_SENSOR_MAX_AXES][4] = {
+    { "accelerometerx", "ax", "accx", "accelx" },
+    { "accelerometery", "ay", "accy", "accely" },
+    { "accelerometerz", "az", "accz", "accelz" },
+    { "gyroscopex", "gx", "gyrox", "gyrx" },
+    { "gyroscopey", "gy", "gyroy", "gyry" },
+    { "gyroscopez", "gz", "gyroz", "gyrz" },
+};
+
+static int csv_split(char *line, char *fields[], int maxfields) {
+    int n = 0;
+    char *tok = line;
+    while (n < maxfields) {
+        fields[n++] = tok;
+        tok = strchr(tok, ',');
+        if (tok == NULL)
+            break;
+        *tok++ = '\0';
+    }
+    return n;
+}
+
+static void csv_normalize(char *dst, const char *src, size_t len) {
+    size_t i = 0;
+    for (; *src && i < len - 1; src++) {
+        if (isalnum((unsigned char) *src))
+            dst[i++] = (char) tolower((unsigned char) *src);
+    }
+    dst[i] = '\0';
+}
+
+static int csv_is_number(const char *field) {
+    char *end;
+    strtol(field, &end, 10);
+    return end != field;
+}
+
+static int csv_next_line(struct csv_sensor_dev *dev, char *line) {
+    while (fgets(line, CSV_SENSOR_LINE_LEN, dev->fp) != NULL) {
+        dev->line++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] != '\0')
+            return CSV_SENSOR_OK;
+    }
+    return CSV_SENSOR_E_EOF;
+}
+
+int csv_sensor_init(struct sensor_device_t *sensor) {
+    struct csv_sensor_dev *dev = &sensor->device;
+    char line[CSV_SENSOR_LINE_LEN];
+    char *fields[CSV_SENSOR_MAX_COLUMNS];
+    long pos;
+    int nfields, found = 0;
+
+    dev->line = 0;
+    for (uint8_t i=0; i < CSV_SENSOR_MAX_AXES; i++)
+        dev->column[i] = (int8_t) i;
+
+    if ((dev->fp = fopen(dev->path, "r")) == NULL)
+        return (sensor->status = CSV_SENSOR_E_OPEN);
+
+    pos = ftell(dev->fp);
+    if (csv_next_line(dev, line) != CSV_SENSOR_OK)
+        return (sensor->status = CSV_SENSOR_E_FORMAT);
+
+    nfields = csv_split(line, fields, CSV_SENSOR_MAX_COLUMNS);
+    if (csv_is_number(fields[0])) {
+        /* No header; replay from the first line */
+        fseek(dev->fp, pos, SEEK_SET);
+        dev->line = 0;
+        return (sensor->status = CSV_SENSOR_OK);
+    }
+
+    for (uint8_t i=0; i < CSV_SENSOR_MAX_AXES; i++) {
+        dev->column[i] = -1;
+        for (int c=0; c < nfields && dev->column[i] < 0; c++) {
+            char name[32];
+            csv_normalize(name, fields[c], sizeof(name));
+            for (uint8_t k=0; k < sizeof(axis_names[i]) / sizeof(axis_names[i][0]); k++) {
+                if (strcmp(name, axis_names[i][k]) == 0) {
+                    dev->column[i] = (int8_t) c;
+                    found++;
+                    break;
+                }
+            }
+        }
+        /* Every axis in use must be present */
+        if ((SNSR_AXIS_MASK & (1U << i)) && dev->column[i] < 0)
+            return (sensor->status = CSV_SENSOR_E_FORMAT);
+    }
+
+    return (sensor->status = (found ? CSV_SENSOR_OK : CSV_SENSOR_E_FORMAT));
+}
+
+int csv_sensor_set_config(struct sensor_device_t *sensor) {
+    /* Nothing to configure; samples are replayed as recorded */
+    return (sensor->status = CSV_SENSOR_OK);
+}
+
+int csv_sensor_read(struct sensor_device_t *sensor, int16_t *ptr) {
+    struct csv_sensor_dev *dev = &sensor->device;
+    char line[CSV_SENSOR_LINE_LEN];
+    char *fields[CSV_SENSOR_MAX_COLUMNS];
+    int status, nfields;
+
+    if ((status = csv_next_line(dev, line)) != CSV_SENSOR_OK)
+        return status;
+
+    nfields = csv_split(line, fields, CSV_SENSOR_MAX_COLUMNS);
+    for (uint8_t i=0; i < CSV_SENSOR_MAX_AXES; i++) {
+        if (SNSR_AXIS_MASK & (1U << i)) {
+            if (dev->column[i] >= nfields || !csv_is_number(fields[dev->column[i]]))
+                return CSV_SENSOR_E_FORMAT;
+            *ptr++ = (int16_t) strtol(fields[dev->column[i]], NULL, 10);
+        }
+    }
+
+    return CSV_SENSOR_OK;
+}
+
+void csv_sensor_close(struct sensor_device_t *sensor) {
+    if (sensor->device.fp != NULL) {
+        fclose(sensor->device.fp);
+        sensor->device.fp = NULL;
+    }
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+  CSV Replay Sensor Header File
+
+  File Name:
+    csv_sensor.h
+
+  Summary:
+    This file defines a sensor driver that replays IMU recordings stored as CSV
+    files (e.g. the released fan condition dataset) for host builds
+
+  Notes:
+    - Columns are matched by header name (AccelerometerX..GyroscopeZ, or
+      ax/ay/az/gx/gy/gz); files without a recognized header are read as
+      AX, AY, AZ, GX, GY, GZ from the first six columns.
+    - Only the axes selected by SNSR_AXIS_MASK are returned.
+ *******************************************************************************/
+#ifndef CSV_SENSOR_H
+#define	CSV_SENSOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define CSV_SENSOR_OK           0
+#define CSV_SENSOR_E_OPEN       -1
+#define CSV_SENSOR_E_FORMAT     -2
+#define CSV_SENSOR_E_EOF        -3
+
+#define CSV_SENSOR_MAX_AXES     6
+#define CSV_SENSOR_LINE_LEN     256
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+struct csv_sensor_dev {
+    const char *path;                       // set before calling sensor_init
+    FILE *fp;
+    int8_t column[CSV_SENSOR_MAX_AXES];     // CSV column of each SNSR_AXIS_* index
+    uint32_t line;
+};
+
+struct sensor_device_t;
+
+int csv_sensor_init(struct sensor_device_t *sensor);
+
+int csv_sensor_set_config(struct sensor_device_t *sensor);
+
+int csv_sensor_read(struct sensor_device_t *sensor, int16_t *ptr);
+
+void csv_sensor_close(struct sensor_device_t *sensor);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CSV_SENSOR_H */
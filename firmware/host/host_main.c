@@ -0,0 +1,274 @@
+/*******************************************************************************
+  Host Pipeline Main Source File
+
+  File Name:
+    host_main.c
+
+  Summary:
+    Runs the firmware acquisition to classification pipeline on the host,
+    replaying IMU recordings from CSV files in place of the sensor
+
+  Description:
+    Samples are read through the CSV replay sensor into the sensor ring buffer
+    one at a time, as the sensor interrupt would, and drained by the same
+    recognition and voting code the firmware uses. Reports the processing rate,
+    the latency distribution of model calls producing a classification and the
+    classifications made for each file.
+
+    usage: sml_host [-q] file.csv [file.csv ...]
+      -q    don't print the per classification output of sml_output
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ringbuffer.h"
+#include "sensor.h"
+#include "app_config.h"
+#include "kb.h"
+#include "sml_output.h"
+#include "sml_recognition_run.h"
+#include "voting.h"
+
+static struct sensor_device_t sensor;
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+static snsr_segment_t _snsr_buffer_data[SNSR_SEGMENT_BUF_LEN];
+static uint16_t snsr_segment_fill = 0;
+#else
+static snsr_data_t _snsr_buffer_data[SNSR_BUF_LEN][SNSR_NUM_AXES];
+#endif
+static ringbuffer_t snsr_buffer;
+
+static bool quiet = false;
+
+// Model calls producing a classification, in ns
+static uint64_t *latencies = NULL;
+static size_t nlatencies = 0, maxlatencies = 0;
+
+// Totals over all files
+static uint64_t total_samples = 0;
+static uint64_t total_model_ns = 0;
+static uint64_t total_read_ns = 0;
+
+#if SML_CADENCE
+// Classifications since the vote last changed, as in main.c
+static uint8_t cadence_stable = 0;
+#endif
+
+static uint64_t timer_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+size_t UART_Write(uint8_t *ptr, const size_t nbytes) {
+    if (!quiet)
+        fwrite(ptr, 1, nbytes, stdout);
+    return nbytes;
+}
+
+size_t UART_Read(uint8_t *ptr, const size_t nbytes) {
+    (void) ptr;
+    (void) nbytes;
+    return 0;
+}
+
+static void Latency_Add(uint64_t ns) {
+    if (nlatencies == maxlatencies) {
+        maxlatencies = maxlatencies ? 2 * maxlatencies : 1024;
+        latencies = realloc(latencies, maxlatencies * sizeof(latencies[0]));
+        if (latencies == NULL) {
+            fprintf(stderr, "ERROR: out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    latencies[nlatencies++] = ns;
+}
+
+static int Latency_Compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+// Equivalent of the sensor interrupt handler; returns the sensor status
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+static int Snsr_Produce(void) {
+    ringbuffer_size_t wrcnt;
+    snsr_segment_t *ptr = ringbuffer_get_write_buffer(&snsr_buffer, &wrcnt);
+    snsr_dataframe_t frame;
+
+    if (wrcnt == 0)
+        return SNSR_STATUS_OK;
+    if ((sensor.status = sensor_read(&sensor, frame)) != SNSR_STATUS_OK)
+        return sensor.status;
+
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+        (*ptr)[i][snsr_segment_fill] = frame[i];
+    if (++snsr_segment_fill == SML_SEGMENT_LEN) {
+        snsr_segment_fill = SML_SEGMENT_LEN - SML_SEGMENT_HOP;
+        ringbuffer_advance_write_index(&snsr_buffer, 1);
+    }
+    return SNSR_STATUS_OK;
+}
+#else
+static int Snsr_Produce(void) {
+    ringbuffer_size_t wrcnt;
+    snsr_data_t *ptr = ringbuffer_get_write_buffer(&snsr_buffer, &wrcnt);
+
+    if (wrcnt == 0)
+        return SNSR_STATUS_OK;
+    if ((sensor.status = sensor_read(&sensor, ptr)) == SNSR_STATUS_OK)
+        ringbuffer_advance_write_index(&snsr_buffer, 1);
+    return sensor.status;
+}
+#endif
+
+#if SML_CADENCE
+// Let the model skip segments while the vote holds, as in main.c
+static void Cadence_Update(int clsid) {
+    if (clsid >= 0 || voting_get_class() < 0)
+        cadence_stable = 0;
+    else if (cadence_stable < SML_CADENCE_STABLE)
+        cadence_stable++;
+    sml_recognition_set_cadence((cadence_stable >= SML_CADENCE_STABLE) ? SML_CADENCE_SKIP : 0);
+}
+#endif
+
+// Equivalent of the main loop; drains the sensor buffer through the model
+static void Snsr_Consume(uint32_t *counts, uint32_t *nchanges) {
+    ringbuffer_size_t rdcnt;
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+    snsr_segment_t *ptr = (snsr_segment_t *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+    while (rdcnt--) {
+#if SML_SEGMENT_HOP < SML_SEGMENT_LEN
+        snsr_segment_t *next = &_snsr_buffer_data[(ptr - _snsr_buffer_data + 1) & (SNSR_SEGMENT_BUF_LEN - 1)];
+        for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+            memcpy(&(*next)[i][0], &(*ptr)[i][SML_SEGMENT_HOP], (SML_SEGMENT_LEN - SML_SEGMENT_HOP) * sizeof(snsr_data_t));
+#endif
+        uint64_t t0 = timer_ns();
+        int ret = sml_recognition_run_segment((snsr_data_t *) ptr++, SML_SEGMENT_LEN, SNSR_NUM_AXES);
+        uint64_t dt = timer_ns() - t0;
+        ringbuffer_advance_read_index(&snsr_buffer, 1);
+#else
+    snsr_dataframe_t const *ptr = (snsr_dataframe_t const *) ringbuffer_get_read_buffer(&snsr_buffer, &rdcnt);
+    while (rdcnt) {
+        int nframes;
+        uint64_t t0 = timer_ns();
+        int ret = sml_recognition_run_batch((snsr_data_t *) ptr, rdcnt, SNSR_NUM_AXES, &nframes);
+        uint64_t dt = timer_ns() - t0;
+        ringbuffer_advance_read_index(&snsr_buffer, nframes);
+        ptr += nframes;
+        rdcnt -= nframes;
+#endif
+        total_model_ns += dt;
+        if (ret >= 0) {
+            Latency_Add(dt);
+            if (ret < NUM_CLASSES)
+                counts[ret]++;
+            int clsid = voting_update(ret);
+            if (clsid >= 0)
+                (*nchanges)++;
+#if SML_CADENCE
+            Cadence_Update(clsid);
+#endif
+        }
+    }
+}
+
+static int Run_File(const char *path) {
+    uint32_t counts[NUM_CLASSES] = {0};
+    uint32_t nchanges = 0;
+    uint64_t nsamples = 0;
+
+    memset(&sensor, 0, sizeof(sensor));
+    sensor.device.path = path;
+    if (sensor_init(&sensor) != SNSR_STATUS_OK || sensor_set_config(&sensor) != SNSR_STATUS_OK) {
+        fprintf(stderr, "ERROR: %s: sensor init result = %d\n", path, sensor.status);
+        csv_sensor_close(&sensor);
+        return sensor.status;
+    }
+
+    ringbuffer_reset(&snsr_buffer);
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+    snsr_segment_fill = 0;
+#endif
+    sml_recognition_reset();
+    voting_reset();
+
+    while (1) {
+        uint64_t t0 = timer_ns();
+        int status = Snsr_Produce();
+        total_read_ns += timer_ns() - t0;
+        if (status == CSV_SENSOR_E_EOF)
+            break;
+        else if (status != SNSR_STATUS_OK) {
+            fprintf(stderr, "ERROR: %s:%u: bad sample\n", path, (unsigned) sensor.device.line);
+            csv_sensor_close(&sensor);
+            return status;
+        }
+        nsamples++;
+        Snsr_Consume(counts, &nchanges);
+    }
+    csv_sensor_close(&sensor);
+    total_samples += nsamples;
+
+    printf("%s: %llu samples, class counts", path, (unsigned long long) nsamples);
+    for (unsigned i=0; i < NUM_CLASSES; i++)
+        printf(" %u:%u", i, (unsigned) counts[i]);
+    printf(", %u vote changes, final class %d\n", (unsigned) nchanges, voting_get_class());
+    return SNSR_STATUS_OK;
+}
+
+int main(int argc, char *argv[]) {
+    int argi = 1, failed = 0;
+
+    if (argi < argc && strcmp(argv[argi], "-q") == 0) {
+        quiet = true;
+        argi++;
+    }
+    if (argi >= argc) {
+        fprintf(stderr, "usage: %s [-q] file.csv [file.csv ...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (ringbuffer_init(&snsr_buffer, _snsr_buffer_data, sizeof(_snsr_buffer_data) / sizeof(_snsr_buffer_data[0]), sizeof(_snsr_buffer_data[0]))) {
+        fprintf(stderr, "ERROR: sensor buffer init failed\n");
+        return EXIT_FAILURE;
+    }
+
+    kb_model_init();
+    sml_output_init(NULL);
+    printf("sensor type is %s with axis mask 0x%02x (%d axes)\n", SNSR_NAME, SNSR_AXIS_MASK, SNSR_NUM_AXES);
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+    printf("segment ingestion enabled with %d sample segments every %d samples\n", SML_SEGMENT_LEN, SML_SEGMENT_HOP);
+#endif
+
+    for (; argi < argc; argi++)
+        failed |= (Run_File(argv[argi]) != SNSR_STATUS_OK);
+
+    printf("\n%llu samples, %.0f samples/s through the model (%.0f samples/s including CSV parsing)\n",
+        (unsigned long long) total_samples,
+        total_model_ns ? 1e9 * total_samples / total_model_ns : 0.0,
+        (total_model_ns + total_read_ns) ? 1e9 * total_samples / (total_model_ns + total_read_ns) : 0.0);
+    if (nlatencies) {
+        qsort(latencies, nlatencies, sizeof(latencies[0]), Latency_Compare);
+        printf("%zu classifications, latency in us: min %.2f p50 %.2f p90 %.2f p99 %.2f max %.2f\n", nlatencies,
+            latencies[0] / 1e3, latencies[nlatencies / 2] / 1e3, latencies[(nlatencies * 9) / 10] / 1e3,
+            latencies[(nlatencies * 99) / 100] / 1e3, latencies[nlatencies - 1] / 1e3);
+    }
+#if SML_GATE
+    uint32_t gated, classified;
+    sml_recognition_gate_stats(&gated, &classified);
+    printf("energy gate at %d LSB: %u segments gated, %u classified\n", SML_GATE_THRESHOLD, (unsigned) gated, (unsigned) classified);
+#endif
+#if SML_CADENCE
+    uint32_t skipped, fallbacks;
+    sml_recognition_cadence_stats(&skipped, &fallbacks);
+    printf("adaptive cadence: %u segments skipped, %u skips cancelled by a range change\n", (unsigned) skipped, (unsigned) fallbacks);
+#endif
+    free(latencies);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
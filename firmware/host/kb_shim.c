@@ -0,0 +1,203 @@
+/*******************************************************************************
+  Knowledge Pack Shim Source File
+
+  File Name:
+    kb_shim.c
+
+  Summary:
+    Stand-in for libsensiml.a on host builds, where the AVR knowledge pack
+    library cannot be linked
+
+  Notes:
+    - Implements the subset of kb.h used by the application with the same
+      pipeline shape as the deployed model: a fixed KB_SHIM_SEGMENT_LEN sample
+      window, the PositiveZeroCrossings, NegativeZeroCrossings and
+      GlobalPeaktoPeakofLowFrequency features and a nearest pattern (PME style)
+      classifier.
+    - With SNSR_FILTER_HZ set the low pass of the peak to peak feature is left
+      to the IMU, as modelled by snsr_filter_bench.c.
+    - The pattern table below is a placeholder and not the trained model; the
+      class IDs it outputs are only meant to exercise the application. Link a
+      host build of the knowledge pack (make KB_LIB=...) for real results.
+ *******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "app_config.h"
+#include "kb.h"
+
+#define KB_SHIM_SEGMENT_LEN     100
+#define KB_SHIM_MAX_SENSORS     6
+#define KB_SHIM_ZC_THRESHOLD    64
+
+// Low pass of GlobalPeaktoPeakofLowFrequency, y += (x - y) >> shift; a
+// knowledge pack for data low pass filtered by the IMU (SNSR_FILTER_HZ)
+// leaves it out (0)
+#ifndef KB_SHIM_LPF_SHIFT
+#if SNSR_FILTER_HZ
+#define KB_SHIM_LPF_SHIFT       0
+#else
+#define KB_SHIM_LPF_SHIFT       2
+#endif
+#endif
+
+typedef struct {
+    uint8_t vector[MAX_VECTOR_SIZE];
+    uint16_t category;
+    uint16_t influence;
+} kb_shim_pattern_t;
+
+static const kb_shim_pattern_t kb_shim_patterns[] = {
+    { {   0,   0,   0 }, 1, 16 },   // off
+    { {  40,  40, 130 }, 3, 32 },   // speed_1
+    { {  60,  60, 130 }, 4, 32 },   // speed_2
+    { {  80,  80, 130 }, 5, 32 },   // speed_3
+    { {  20,  20, 200 }, 2, 64 },   // shaking
+    { {  10,  10, 255 }, 6, 64 },   // tapping
+};
+
+static SENSOR_DATA_T kb_shim_window[KB_SHIM_SEGMENT_LEN][KB_SHIM_MAX_SENSORS];
+static int kb_shim_fill = 0;
+static int kb_shim_nsensors = 0;
+static uint16_t const *kb_shim_segment = NULL;
+static int kb_shim_seglen = 0;
+static uint8_t kb_shim_fv[MAX_VECTOR_SIZE];
+static const uint8_t kb_shim_uuid[16] = { 0 };
+
+static uint8_t kb_shim_scale(int32_t value, int32_t full_scale) {
+    int32_t v = (value * 255) / full_scale;
+    return (uint8_t) (v > 255 ? 255 : (v < 0 ? 0 : v));
+}
+
+// Sample n of channel c in either the streamed window or a registered segment
+static int32_t kb_shim_sample(int n, int c) {
+    if (kb_shim_segment != NULL)
+        return (int16_t) kb_shim_segment[c * kb_shim_seglen + n];
+    return kb_shim_window[n][c];
+}
+
+static void kb_shim_features(int len, int nsensors) {
+    int32_t mean = 0;
+    int pos = 0, neg = 0, state = 0;
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+
+    /* Zero crossings of the first channel about its mean */
+    for (int n=0; n < len; n++)
+        mean += kb_shim_sample(n, 0);
+    mean /= len;
+    for (int n=0; n < len; n++) {
+        int32_t x = kb_shim_sample(n, 0) - mean;
+        if (x > KB_SHIM_ZC_THRESHOLD && state <= 0) {
+            pos += (state < 0);
+            state = 1;
+        }
+        else if (x < -KB_SHIM_ZC_THRESHOLD && state >= 0) {
+            neg += (state > 0);
+            state = -1;
+        }
+    }
+
+    /* Peak to peak of the low pass filtered channels */
+    for (int c=0; c < nsensors; c++) {
+        int32_t y = kb_shim_sample(0, c);
+        for (int n=1; n < len; n++) {
+#if KB_SHIM_LPF_SHIFT
+            y += (kb_shim_sample(n, c) - y) >> KB_SHIM_LPF_SHIFT;
+#else
+            y = kb_shim_sample(n, c);
+#endif
+            if (y < lo)
+                lo = y;
+            if (y > hi)
+                hi = y;
+        }
+    }
+
+    kb_shim_fv[0] = kb_shim_scale(pos, len / 2);
+    kb_shim_fv[1] = kb_shim_scale(neg, len / 2);
+    kb_shim_fv[2] = kb_shim_scale(hi - lo, 32768);
+}
+
+static int kb_shim_classify(void) {
+    int best = 0;
+    uint32_t bestdist = UINT32_MAX;
+
+    for (unsigned p=0; p < sizeof(kb_shim_patterns) / sizeof(kb_shim_patterns[0]); p++) {
+        uint32_t dist = 0;
+        for (int i=0; i < MAX_VECTOR_SIZE; i++) {
+            int d = (int) kb_shim_fv[i] - kb_shim_patterns[p].vector[i];
+            dist += (uint32_t) (d < 0 ? -d : d);
+        }
+        if (dist <= kb_shim_patterns[p].influence && dist < bestdist) {
+            bestdist = dist;
+            best = kb_shim_patterns[p].category;
+        }
+    }
+
+    return best;
+}
+
+void kb_model_init() {
+    kb_reset_model(0);
+}
+
+int kb_reset_model(int model_index) {
+    (void) model_index;
+    kb_shim_fill = 0;
+    return 0;
+}
+
+int kb_flush_model_buffer(int model_index) {
+    (void) model_index;
+    kb_shim_fill = 0;
+    kb_shim_segment = NULL;
+    return 0;
+}
+
+int kb_run_model(SENSOR_DATA_T *pSample, int nsensors, int model_index) {
+    (void) model_index;
+    if (nsensors > KB_SHIM_MAX_SENSORS)
+        return -2;
+
+    memcpy(kb_shim_window[kb_shim_fill], pSample, nsensors * sizeof(SENSOR_DATA_T));
+    kb_shim_nsensors = nsensors;
+    if (++kb_shim_fill < KB_SHIM_SEGMENT_LEN)
+        return -1;
+
+    kb_shim_segment = NULL;
+    kb_shim_features(KB_SHIM_SEGMENT_LEN, nsensors);
+    kb_shim_fill = 0;
+    return kb_shim_classify();
+}
+
+void kb_add_segment(uint16_t *pBuffer, int len, int nbuffs, int model_index) {
+    (void) model_index;
+    kb_shim_segment = pBuffer;
+    kb_shim_seglen = len;
+    kb_shim_nsensors = nbuffs;
+}
+
+int kb_run_segment(int model_index) {
+    (void) model_index;
+    if (kb_shim_segment == NULL)
+        return -2;
+
+    kb_shim_features(kb_shim_seglen, kb_shim_nsensors);
+    kb_shim_segment = NULL;
+    return kb_shim_classify();
+}
+
+int kb_get_segment_length(int model_index) {
+    (void) model_index;
+    return KB_SHIM_SEGMENT_LEN;
+}
+
+const uint8_t *kb_get_model_uuid_ptr(int model_index) {
+    (void) model_index;
+    return kb_shim_uuid;
+}
+
+void kb_get_feature_vector(int model_index, uint8_t *fv_arr, uint8_t *p_fv_len) {
+    (void) model_index;
+    memcpy(fv_arr, kb_shim_fv, MAX_VECTOR_SIZE);
+    *p_fv_len = MAX_VECTOR_SIZE;
+}
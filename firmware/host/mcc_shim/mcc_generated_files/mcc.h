@@ -0,0 +1,72 @@
+/*******************************************************************************
+  Host MCC Stand-in Header File
+
+  File Name:
+    mcc.h
+
+  Summary:
+    Replaces mcc_generated_files/mcc.h for host builds of the sensor drivers
+
+  Description:
+    Declares the subset of the MCC SPI0, TWI0 master, pin manager and atomic
+    API used by the sensor wrappers in app_config/ and snsr_bus_stats.c, with
+    the same names and types as the generated drivers. The functions are implemented by bus_sim.c. Put this
+    directory ahead of the firmware project directory on the include path.
+ *******************************************************************************/
+#ifndef MCC_H
+#define MCC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bus_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Critical sections (utils/atomic.h); the host build is single threaded
+#define ENTER_CRITICAL(P)   do {} while (0)
+#define EXIT_CRITICAL(P)    do {} while (0)
+
+// SPI0 (spi0.h)
+uint8_t SPI0_ExchangeByte(uint8_t data);
+void SPI0_ExchangeBlock(void *block, size_t size);
+void SPI0_WriteBlock(void *block, size_t size);
+void SPI0_ReadBlock(void *block, size_t size);
+
+// MikroBus 1 chip select (pin_manager.h)
+void MIKRO1_CS_SetLow(void);
+void MIKRO1_CS_SetHigh(void);
+
+// TWI0 master (twi0_master.h)
+typedef enum {
+    I2C0_NOERR,
+    I2C0_BUSY,
+    I2C0_FAIL
+} twi0_error_t;
+
+typedef enum { I2C0_STOP = 1, I2C0_RESTART_READ, I2C0_RESTART_WRITE, I2C0_CONTINUE, I2C0_RESET_LINK } twi0_operations_t;
+
+typedef twi0_operations_t (*twi0_callback_t)(void *funPtr);
+
+typedef uint8_t twi0_address_t;
+typedef twi0_address_t i2c_address_t;
+
+twi0_operations_t I2C0_SetReturnStopCallback(void *funPtr);
+twi0_operations_t I2C0_SetReturnResetCallback(void *funPtr);
+twi0_operations_t I2C0_SetRestartWriteCallback(void *funPtr);
+twi0_operations_t I2C0_SetRestartReadCallback(void *funPtr);
+
+twi0_error_t I2C0_Open(twi0_address_t address);
+twi0_error_t I2C0_Close(void);
+twi0_error_t I2C0_MasterOperation(bool read);
+void I2C0_SetBuffer(void *buffer, size_t bufferSize);
+void I2C0_SetDataCompleteCallback(twi0_callback_t cb, void *funPtr);
+void I2C0_SetAddressNackCallback(twi0_callback_t cb, void *funPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCC_H */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+  Simulated BMI160 Source File
+
+  File Name:
+    sim_bmi160.c
+
+  Summary:
+    Register level model of the BMI160 on an I2C or 4 wire SPI bus
+
+  Notes:
+    - See sim_sensor.h
+    - I2C protocol: the first byte of a write transfer sets the register
+      pointer, further bytes are written to consecutive registers; read
+      transfers return consecutive registers from the pointer
+    - SPI protocol: as the ICM42688 (see sim_icm42688.c), with no dummy byte
+      before read data. The device starts in I2C mode; SPI transfers are
+      ignored until a rising edge on CS selects SPI. A soft reset returns
+      to I2C mode
+    - Commands written to CMD (0x7E) take effect immediately: soft reset,
+      accel/gyro power modes (reflected in PMU_STATUS), FIFO flush and
+      interrupt reset
+    - FIFO frames are stored in header or headerless mode as configured in
+      FIFO_CONFIG_1; sensor time frames are not generated. Reading past the
+      end of the FIFO returns 0x80 (over-read)
+ *******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "bus_sim.h"
+#include "sim_sensor.h"
+#include "bmi160_defs.h"
+
+#define BMI_FIFO_SIZE           1024
+#define BMI_FIFO_OVERREAD       0x80
+
+// Register bits not named in bmi160_defs.h
+#define BMI_STATUS_DRDY_ACC     0x80
+#define BMI_STATUS_DRDY_GYR     0x40
+#define BMI_INT_STATUS1_FWM     0x40
+#define BMI_INT_STATUS1_FFULL   0x20
+#define BMI_INT_STATUS1_DRDY    0x10
+#define BMI_FIFO_CFG1_GYR_EN    0x80
+#define BMI_FIFO_CFG1_ACC_EN    0x40
+#define BMI_FIFO_CFG1_HEADER_EN 0x10
+#define BMI_FIFO_HEADER_REGULAR 0x80
+#define BMI_FIFO_HEADER_GYR     0x08
+#define BMI_FIFO_HEADER_ACC     0x04
+#define BMI_PMU_NORMAL          1
+#define BMI_INT_RESET_CMD       0xB1
+
+static uint8_t regs[128];
+static uint8_t fifo[BMI_FIFO_SIZE];
+static uint16_t fifo_rd, fifo_count;
+
+static enum { I2C_IDLE, I2C_POINTER, I2C_WRITE, I2C_READ } i2c_state;
+static uint8_t i2c_reg;
+
+static enum { SPI_IDLE, SPI_ADDRESS, SPI_READ, SPI_WRITE } spi_state;
+static uint8_t spi_reg;
+static bool spi_mode, spi_reset;
+
+static void bmi_reset(void) {
+    memset(regs, 0, sizeof(regs));
+    fifo_rd = fifo_count = 0;
+
+    regs[BMI160_CHIP_ID_ADDR]       = BMI160_CHIP_ID;
+    regs[BMI160_ACCEL_CONFIG_ADDR]  = 0x28;
+    regs[BMI160_ACCEL_RANGE_ADDR]   = 0x03;
+    regs[BMI160_GYRO_CONFIG_ADDR]   = 0x28;
+    regs[BMI160_GYRO_RANGE_ADDR]    = 0x00;
+    regs[0x44]                      = 0x0B;     // MAG_CONF
+    regs[BMI160_FIFO_DOWN_ADDR]     = 0x88;
+    regs[BMI160_FIFO_CONFIG_0_ADDR] = 0x80;
+    regs[BMI160_FIFO_CONFIG_1_ADDR] = 0x10;
+}
+
+static uint16_t bmi_fifo_frame_len(void) {
+    uint8_t cfg = regs[BMI160_FIFO_CONFIG_1_ADDR];
+    return ((cfg & BMI_FIFO_CFG1_HEADER_EN) ? 1 : 0) + ((cfg & BMI_FIFO_CFG1_GYR_EN) ? 6 : 0)
+        + ((cfg & BMI_FIFO_CFG1_ACC_EN) ? 6 : 0);
+}
+
+static void bmi_fifo_update_status(void) {
+    uint16_t wm = 4 * regs[BMI160_FIFO_CONFIG_0_ADDR];
+    if (wm != 0 && fifo_count >= wm)
+        regs[BMI160_INT_STATUS_ADDR + 1] |= BMI_INT_STATUS1_FWM;
+    else
+        regs[BMI160_INT_STATUS_ADDR + 1] &= (uint8_t) ~BMI_INT_STATUS1_FWM;
+    if (fifo_count + bmi_fifo_frame_len() > BMI_FIFO_SIZE)
+        regs[BMI160_INT_STATUS_ADDR + 1] |= BMI_INT_STATUS1_FFULL;
+    else
+        regs[BMI160_INT_STATUS_ADDR + 1] &= (uint8_t) ~BMI_INT_STATUS1_FFULL;
+    regs[BMI160_FIFO_LENGTH_ADDR] = (uint8_t) fifo_count;
+    regs[BMI160_FIFO_LENGTH_ADDR + 1] = (uint8_t) (fifo_count >> 8);
+}
+
+static void bmi_fifo_push(const uint8_t *frame, uint16_t len) {
+    /* The FIFO runs in stream mode; drop the oldest frame when full */
+    if (fifo_count + len > BMI_FIFO_SIZE) {
+        fifo_rd = (fifo_rd + len) % BMI_FIFO_SIZE;
+        fifo_count -= len;
+    }
+    for (uint16_t i=0; i < len; i++)
+        fifo[(fifo_rd + fifo_count++) % BMI_FIFO_SIZE] = frame[i];
+    bmi_fifo_update_status();
+}
+
+static uint8_t bmi_fifo_pop(void) {
+    uint8_t value;
+    if (fifo_count == 0)
+        return BMI_FIFO_OVERREAD;
+    value = fifo[fifo_rd];
+    fifo_rd = (fifo_rd + 1) % BMI_FIFO_SIZE;
+    fifo_count--;
+    bmi_fifo_update_status();
+    return value;
+}
+
+static uint8_t bmi_read(uint8_t reg) {
+    switch (reg) {
+        case BMI160_FIFO_DATA_ADDR:
+            return bmi_fifo_pop();
+        case BMI160_COMMAND_REG_ADDR:
+            return 0;
+        default:
+            /* Reading the data registers clears the data ready flags */
+            if (reg >= BMI160_GYRO_DATA_ADDR && reg < BMI160_ACCEL_DATA_ADDR)
+                regs[BMI160_STATUS_ADDR] &= (uint8_t) ~BMI_STATUS_DRDY_GYR;
+            else if (reg >= BMI160_ACCEL_DATA_ADDR && reg < BMI160_ACCEL_DATA_ADDR + 6)
+                regs[BMI160_STATUS_ADDR] &= (uint8_t) ~BMI_STATUS_DRDY_ACC;
+            return regs[reg];
+    }
+}
+
+static void bmi_command(uint8_t cmd) {
+    if (cmd == BMI160_SOFT_RESET_CMD) {
+        bmi_reset();
+        spi_reset = true;
+    }
+    else if (cmd == BMI160_FIFO_FLUSH_VALUE) {
+        fifo_rd = fifo_count = 0;
+        bmi_fifo_update_status();
+    }
+    else if (cmd == BMI_INT_RESET_CMD)
+        memset(&regs[BMI160_INT_STATUS_ADDR], 0, 4);
+    else if (cmd >= 0x10 && cmd <= 0x12)
+        regs[BMI160_PMU_STATUS_ADDR] = (regs[BMI160_PMU_STATUS_ADDR] & 0xCF) | ((cmd & 0x03) << 4);
+    else if (cmd >= 0x14 && cmd <= 0x17)
+        regs[BMI160_PMU_STATUS_ADDR] = (regs[BMI160_PMU_STATUS_ADDR] & 0xF3) | ((cmd & 0x03) << 2);
+}
+
+static void bmi_write(uint8_t reg, uint8_t value) {
+    if (reg == BMI160_COMMAND_REG_ADDR)
+        bmi_command(value);
+    else if (reg == BMI160_FIFO_CONFIG_0_ADDR || reg == BMI160_FIFO_CONFIG_1_ADDR) {
+        regs[reg] = value;
+        bmi_fifo_update_status();
+    }
+    else if (reg >= BMI160_ACCEL_CONFIG_ADDR && reg < BMI160_COMMAND_REG_ADDR)
+        regs[reg] = value;
+    /* else read only */
+}
+
+static bool bmi_start(bool read) {
+    i2c_state = read ? I2C_READ : I2C_POINTER;
+    return true;
+}
+
+static void bmi_i2c_write(uint8_t data) {
+    if (i2c_state == I2C_POINTER) {
+        i2c_reg = data & 0x7F;
+        i2c_state = I2C_WRITE;
+    }
+    else if (i2c_state == I2C_WRITE) {
+        bmi_write(i2c_reg, data);
+        i2c_reg = (i2c_reg + 1) & 0x7F;
+    }
+}
+
+// Read the register at *reg and auto-increment, except on the FIFO data register
+static uint8_t bmi_read_next(uint8_t *reg) {
+    uint8_t value = bmi_read(*reg);
+    if (*reg != BMI160_FIFO_DATA_ADDR)
+        *reg = (*reg + 1) & 0x7F;
+    return value;
+}
+
+static uint8_t bmi_i2c_read(void) {
+    return bmi_read_next(&i2c_reg);
+}
+
+static void bmi_stop(void) {
+    i2c_state = I2C_IDLE;
+}
+
+static const struct bus_sim_i2c_dev bmi_i2c = {
+    .address = BMI160_I2C_ADDR,
+    .start = bmi_start,
+    .write = bmi_i2c_write,
+    .read = bmi_i2c_read,
+    .stop = bmi_stop,
+};
+
+static void bmi_select(bool asserted) {
+    spi_state = asserted ? SPI_ADDRESS : SPI_IDLE;
+    if (!asserted) {
+        /* The rising edge selects SPI, unless the transfer reset the device */
+        spi_mode = !spi_reset;
+        spi_reset = false;
+    }
+}
+
+static uint8_t bmi_exchange(uint8_t mosi) {
+    uint8_t miso = 0;
+
+    if (!spi_mode)
+        return miso;
+
+    switch (spi_state) {
+        case SPI_ADDRESS:
+            spi_reg = mosi & 0x7F;
+            spi_state = (mosi & 0x80) ? SPI_READ : SPI_WRITE;
+            break;
+        case SPI_READ:
+            miso = bmi_read_next(&spi_reg);
+            break;
+        case SPI_WRITE:
+            bmi_write(spi_reg, mosi);
+            spi_reg = (spi_reg + 1) & 0x7F;
+            break;
+        default:
+            break;
+    }
+    return miso;
+}
+
+static const struct bus_sim_spi_dev bmi_spi = {
+    .select = bmi_select,
+    .exchange = bmi_exchange,
+};
+
+void sim_bmi160_attach(void) {
+    bmi_reset();
+    i2c_state = I2C_IDLE;
+    bus_sim_attach_i2c(&bmi_i2c);
+}
+
+void sim_bmi160_attach_spi(void) {
+    bmi_reset();
+    spi_state = SPI_IDLE;
+    spi_mode = spi_reset = false;
+    bus_sim_attach_spi(&bmi_spi);
+}
+
+void sim_bmi160_tick(const int16_t sample[SIM_SENSOR_AXES]) {
+    uint8_t pmu = regs[BMI160_PMU_STATUS_ADDR];
+    bool accel_on = ((pmu >> 4) & 0x03) == BMI_PMU_NORMAL;
+    bool gyro_on = ((pmu >> 2) & 0x03) == BMI_PMU_NORMAL;
+    uint8_t cfg = regs[BMI160_FIFO_CONFIG_1_ADDR];
+    uint32_t sensortime = (uint32_t) ((read_timer_us() * 16) / 625);    // 39.0625us ticks
+
+    if (!accel_on && !gyro_on)
+        return;
+
+    for (uint8_t i=0; i < SIM_SENSOR_AXES; i++) {
+        uint8_t reg = (i < 3) ? BMI160_ACCEL_DATA_ADDR + 2 * i : BMI160_GYRO_DATA_ADDR + 2 * (i - 3);
+        if ((i < 3) ? accel_on : gyro_on) {
+            regs[reg] = (uint8_t) sample[i];
+            regs[reg + 1] = (uint8_t) ((uint16_t) sample[i] >> 8);
+        }
+    }
+    regs[0x18] = (uint8_t) sensortime;
+    regs[0x19] = (uint8_t) (sensortime >> 8);
+    regs[0x1A] = (uint8_t) (sensortime >> 16);
+    regs[BMI160_STATUS_ADDR] |= (accel_on ? BMI_STATUS_DRDY_ACC : 0) | (gyro_on ? BMI_STATUS_DRDY_GYR : 0);
+    regs[BMI160_INT_STATUS_ADDR + 1] |= BMI_INT_STATUS1_DRDY;
+
+    if ((cfg & BMI_FIFO_CFG1_GYR_EN && gyro_on) || (cfg & BMI_FIFO_CFG1_ACC_EN && accel_on)) {
+        uint8_t frame[13];
+        uint16_t len = 0;
+
+        if (cfg & BMI_FIFO_CFG1_HEADER_EN) {
+            frame[len++] = BMI_FIFO_HEADER_REGULAR | ((cfg & BMI_FIFO_CFG1_GYR_EN) ? BMI_FIFO_HEADER_GYR : 0)
+                | ((cfg & BMI_FIFO_CFG1_ACC_EN) ? BMI_FIFO_HEADER_ACC : 0);
+        }
+        /* Frame data order is gyro then accel */
+        for (uint8_t k=0; k < SIM_SENSOR_AXES; k++) {
+            uint8_t i = (k + 3) % SIM_SENSOR_AXES;
+            if (cfg & ((i < 3) ? BMI_FIFO_CFG1_ACC_EN : BMI_FIFO_CFG1_GYR_EN)) {
+                frame[len++] = (uint8_t) sample[i];
+                frame[len++] = (uint8_t) ((uint16_t) sample[i] >> 8);
+            }
+        }
+        bmi_fifo_push(frame, len);
+    }
+}
+
+uint16_t sim_bmi160_fifo_level(void) {
+    return fifo_count;
+}
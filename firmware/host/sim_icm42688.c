@@ -0,0 +1,262 @@
+/*******************************************************************************
+  Simulated ICM42688 Source File
+
+  File Name:
+    sim_icm42688.c
+
+  Summary:
+    Register level model of the ICM42688 on a 4 wire SPI bus
+
+  Notes:
+    - See sim_sensor.h
+    - SPI protocol: the first byte after CS is asserted holds the register
+      address with the read flag in bit 7; the following bytes read or write
+      consecutive registers of the selected bank
+    - The FIFO always stores 16 byte packets (header, accel, gyro, 8 bit
+      temperature, timestamp), which is the format the driver parses; the
+      data of a sensor that is off is stored as -32768 (invalid)
+ *******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "bus_sim.h"
+#include "sim_sensor.h"
+#include "Icm426xxDefs.h"
+
+#define ICM_NUM_BANKS           5
+#define ICM_FIFO_SIZE           2048
+#define ICM_FIFO_PACKET_SIZE    16
+#define ICM_FIFO_EMPTY_VALUE    0xFF
+
+static uint8_t regs[ICM_NUM_BANKS][128];
+static uint8_t bank;
+
+static uint8_t fifo[ICM_FIFO_SIZE];
+static uint16_t fifo_rd, fifo_count;
+
+static enum { SPI_IDLE, SPI_ADDRESS, SPI_READ, SPI_WRITE } spi_state;
+static uint8_t spi_reg;
+
+static void icm_reset(void) {
+    memset(regs, 0, sizeof(regs));
+    bank = 0;
+    fifo_rd = fifo_count = 0;
+
+    regs[0][MPUREG_INT_CONFIG]          = 0x00;
+    regs[0][MPUREG_FIFO_CONFIG]         = 0x00;
+    regs[0][MPUREG_INT_STATUS]          = BIT_INT_STATUS_RESET_DONE;
+    regs[0][MPUREG_INTF_CONFIG0]        = 0x30;
+    regs[0][MPUREG_INTF_CONFIG1]        = 0x91;
+    regs[0][MPUREG_GYRO_CONFIG0]        = 0x06;
+    regs[0][MPUREG_ACCEL_CONFIG0]       = 0x06;
+    regs[0][MPUREG_GYRO_CONFIG1]        = 0x16;
+    regs[0][MPUREG_ACCEL_GYRO_CONFIG0]  = 0x11;
+    regs[0][MPUREG_ACCEL_CONFIG1]       = 0x0D;
+    regs[0][MPUREG_TMST_CONFIG]         = 0x23;
+    regs[0][MPUREG_SMD_CONFIG]          = 0x00;
+    regs[0][MPUREG_FSYNC_CONFIG]        = 0x10;
+    regs[0][MPUREG_INT_CONFIG1]         = 0x10;
+    regs[0][MPUREG_INT_SOURCE0]         = 0x10;
+    regs[0][MPUREG_WHO_AM_I]            = ICM42688_WHOAMI;
+    regs[1][MPUREG_INTF_CONFIG4_B1]     = 0x83;
+    regs[1][MPUREG_INTF_CONFIG5_B1]     = 0x00;
+    regs[1][MPUREG_INTF_CONFIG6_B1]     = 0x5F;
+    /* Gyro trim registers touched by the driver at init */
+    regs[3][0x2E] = 0xFF;
+    regs[3][0x32] = 0xFF;
+    regs[3][0x37] = 0xFF;
+    regs[3][0x3C] = 0xFF;
+
+    /* Data registers read as invalid until the first sample */
+    for (uint8_t r = MPUREG_ACCEL_DATA_X0_UI; r < MPUREG_ACCEL_DATA_X0_UI + 12; r += 2) {
+        regs[0][r] = 0x80;
+        regs[0][r + 1] = 0x00;
+    }
+}
+
+static bool icm_fifo_count_records(void) {
+    return (regs[0][MPUREG_INTF_CONFIG0] & BIT_FIFO_COUNT_REC_MASK) != 0;
+}
+
+static uint16_t icm_fifo_count(void) {
+    return icm_fifo_count_records() ? fifo_count / ICM_FIFO_PACKET_SIZE : fifo_count;
+}
+
+static uint16_t icm_fifo_watermark(void) {
+    return regs[0][MPUREG_FIFO_CONFIG2] | ((regs[0][MPUREG_FIFO_CONFIG2 + 1] & 0x0F) << 8);
+}
+
+static void icm_fifo_update_status(void) {
+    uint16_t wm = icm_fifo_watermark();
+    if (wm != 0 && icm_fifo_count() >= wm)
+        regs[0][MPUREG_INT_STATUS] |= BIT_INT_STATUS_FIFO_THS;
+    if (fifo_count + ICM_FIFO_PACKET_SIZE > ICM_FIFO_SIZE)
+        regs[0][MPUREG_INT_STATUS] |= BIT_INT_STATUS_FIFO_FULL;
+}
+
+static void icm_fifo_push(const uint8_t *packet) {
+    if (fifo_count + ICM_FIFO_PACKET_SIZE > ICM_FIFO_SIZE) {
+        if ((regs[0][MPUREG_FIFO_CONFIG] & BIT_FIFO_CONFIG_MODE_MASK) == ICM426XX_FIFO_CONFIG_MODE_STOP_ON_FULL)
+            return;
+        /* Stream mode; drop the oldest packet */
+        fifo_rd = (fifo_rd + ICM_FIFO_PACKET_SIZE) % ICM_FIFO_SIZE;
+        fifo_count -= ICM_FIFO_PACKET_SIZE;
+    }
+    for (uint8_t i=0; i < ICM_FIFO_PACKET_SIZE; i++)
+        fifo[(fifo_rd + fifo_count++) % ICM_FIFO_SIZE] = packet[i];
+    icm_fifo_update_status();
+}
+
+static uint8_t icm_fifo_pop(void) {
+    uint8_t value;
+    if (fifo_count == 0)
+        return ICM_FIFO_EMPTY_VALUE;
+    value = fifo[fifo_rd];
+    fifo_rd = (fifo_rd + 1) % ICM_FIFO_SIZE;
+    fifo_count--;
+    return value;
+}
+
+static uint8_t icm_read(uint8_t reg) {
+    uint8_t value;
+
+    if (reg == MPUREG_REG_BANK_SEL)
+        return bank;
+    if (bank != 0)
+        return regs[bank][reg];
+
+    switch (reg) {
+        case MPUREG_INT_STATUS:
+            /* Clear on read */
+            value = regs[0][reg];
+            regs[0][reg] = 0;
+            return value;
+        case MPUREG_FIFO_COUNTH:
+        case MPUREG_FIFO_COUNTL:
+            value = ((reg == MPUREG_FIFO_COUNTH) == ((regs[0][MPUREG_INTF_CONFIG0] & BIT_FIFO_COUNT_ENDIAN_MASK) != 0)) ?
+                (uint8_t) (icm_fifo_count() >> 8) : (uint8_t) icm_fifo_count();
+            return value;
+        case MPUREG_FIFO_DATA:
+            return icm_fifo_pop();
+        default:
+            return regs[0][reg];
+    }
+}
+
+static void icm_write(uint8_t reg, uint8_t value) {
+    if (reg == MPUREG_REG_BANK_SEL) {
+        bank = (value < ICM_NUM_BANKS) ? value : 0;
+        return;
+    }
+    if (bank != 0) {
+        regs[bank][reg] = value;
+        return;
+    }
+
+    switch (reg) {
+        case MPUREG_WHO_AM_I:
+        case MPUREG_INT_STATUS:
+        case MPUREG_FIFO_COUNTH:
+        case MPUREG_FIFO_COUNTL:
+        case MPUREG_FIFO_DATA:
+            /* Read only */
+            break;
+        case MPUREG_DEVICE_CONFIG:
+            if (value & ICM426XX_DEVICE_CONFIG_RESET_EN)
+                icm_reset();
+            else
+                regs[0][reg] = value;
+            break;
+        case MPUREG_SIGNAL_PATH_RESET:
+            if (value & BIT_SIGNAL_PATH_RESET_FIFO_FLUSH_MASK)
+                fifo_rd = fifo_count = 0;
+            regs[0][reg] = value & (uint8_t) ~BIT_SIGNAL_PATH_RESET_FIFO_FLUSH_MASK;
+            break;
+        case MPUREG_FIFO_CONFIG:
+            regs[0][reg] = value;
+            if ((value & BIT_FIFO_CONFIG_MODE_MASK) == ICM426XX_FIFO_CONFIG_MODE_BYPASS)
+                fifo_rd = fifo_count = 0;
+            break;
+        default:
+            regs[0][reg] = value;
+    }
+}
+
+static void icm_select(bool asserted) {
+    spi_state = asserted ? SPI_ADDRESS : SPI_IDLE;
+}
+
+static uint8_t icm_exchange(uint8_t mosi) {
+    uint8_t miso = 0;
+
+    switch (spi_state) {
+        case SPI_ADDRESS:
+            spi_reg = mosi & 0x7F;
+            spi_state = (mosi & 0x80) ? SPI_READ : SPI_WRITE;
+            break;
+        case SPI_READ:
+            miso = icm_read(spi_reg);
+            if (spi_reg != MPUREG_FIFO_DATA || bank != 0)
+                spi_reg = (spi_reg + 1) & 0x7F;
+            break;
+        case SPI_WRITE:
+            icm_write(spi_reg, mosi);
+            spi_reg = (spi_reg + 1) & 0x7F;
+            break;
+        default:
+            break;
+    }
+    return miso;
+}
+
+static const struct bus_sim_spi_dev icm_spi = {
+    .select = icm_select,
+    .exchange = icm_exchange,
+};
+
+void sim_icm42688_attach(void) {
+    icm_reset();
+    spi_state = SPI_IDLE;
+    bus_sim_attach_spi(&icm_spi);
+}
+
+static void icm_put16(uint8_t *dst, int16_t value, bool big_endian) {
+    dst[big_endian ? 0 : 1] = (uint8_t) ((uint16_t) value >> 8);
+    dst[big_endian ? 1 : 0] = (uint8_t) value;
+}
+
+void sim_icm42688_tick(const int16_t sample[SIM_SENSOR_AXES]) {
+    uint8_t pwr = regs[0][MPUREG_PWR_MGMT_0];
+    bool accel_on = (pwr & BIT_PWR_MGMT_0_ACCEL_MODE_MASK) >= ICM426XX_PWR_MGMT_0_ACCEL_MODE_LP;
+    bool gyro_on = (pwr & BIT_PWR_MGMT_0_GYRO_MODE_MASK) == ICM426XX_PWR_MGMT_0_GYRO_MODE_LN;
+    bool big_endian = (regs[0][MPUREG_INTF_CONFIG0] & BIT_DATA_ENDIAN_MASK) != 0;
+    uint8_t fifo_cfg1 = regs[0][MPUREG_FIFO_CONFIG1];
+
+    if (!accel_on && !gyro_on)
+        return;
+
+    for (uint8_t i=0; i < SIM_SENSOR_AXES; i++) {
+        if ((i < 3) ? accel_on : gyro_on)
+            icm_put16(&regs[0][MPUREG_ACCEL_DATA_X0_UI + 2 * i], sample[i], big_endian);
+    }
+    regs[0][MPUREG_INT_STATUS] |= BIT_INT_STATUS_DRDY;
+
+    if ((regs[0][MPUREG_FIFO_CONFIG] & BIT_FIFO_CONFIG_MODE_MASK) != ICM426XX_FIFO_CONFIG_MODE_BYPASS
+        && (fifo_cfg1 & (BIT_FIFO_CONFIG1_ACCEL_MASK | BIT_FIFO_CONFIG1_GYRO_MASK))) {
+        uint8_t packet[ICM_FIFO_PACKET_SIZE];
+        uint16_t tmst = (uint16_t) (read_timer_us() / 16);
+
+        packet[0] = 0x40 | 0x20 | ((fifo_cfg1 & BIT_FIFO_CONFIG1_TMST_FSYNC_MASK) ? 0x08 : 0x00);
+        for (uint8_t i=0; i < SIM_SENSOR_AXES; i++) {
+            bool on = (i < 3) ? (accel_on && (fifo_cfg1 & BIT_FIFO_CONFIG1_ACCEL_MASK))
+                              : (gyro_on && (fifo_cfg1 & BIT_FIFO_CONFIG1_GYRO_MASK));
+            icm_put16(&packet[1 + 2 * i], on ? sample[i] : INVALID_VALUE_FIFO, big_endian);
+        }
+        packet[13] = 25;
+        icm_put16(&packet[14], (int16_t) tmst, big_endian);
+        icm_fifo_push(packet);
+    }
+}
+
+uint16_t sim_icm42688_fifo_level(void) {
+    return fifo_count;
+}
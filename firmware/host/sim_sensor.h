@@ -0,0 +1,61 @@
+/*******************************************************************************
+  Simulated IMU Sensors Header File
+
+  File Name:
+    sim_sensor.h
+
+  Summary:
+    Register level models of the ICM42688 (SPI) and BMI160 (I2C or SPI) IMUs for
+    running the vendor drivers on the host
+
+  Description:
+    Each model holds the register map of the device and decodes the bus
+    traffic it receives through bus_sim. Modelled behavior:
+      - WHO_AM_I / CHIP_ID, soft reset to the power-on register values and
+        the register bank select (ICM42688) or command register (BMI160)
+      - accel and gyro power modes; data registers are only updated for
+        sensors that are on
+      - data ready in INT_STATUS (ICM42688) and STATUS/INT_STATUS (BMI160)
+      - the FIFO, including record/byte counts, endianness, watermark and
+        full flags, and the over-read behavior of each device
+      - register address auto-increment, except on the FIFO data register
+    Filters, ODR timing, interrupt pins and the APEX/motion engines are not
+    modelled. Samples are generated only when the *_tick() function is
+    called, one call per ODR period.
+ *******************************************************************************/
+#ifndef SIM_SENSOR_H
+#define SIM_SENSOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of values in a sample passed to the *_tick() functions, in
+// SNSR_AXIS_* order: AX, AY, AZ, GX, GY, GZ
+#define SIM_SENSOR_AXES     6
+
+// Put the model in its power-on state and attach it to the bus
+void sim_icm42688_attach(void);
+
+// Latch a new sample into the data registers and the FIFO
+void sim_icm42688_tick(const int16_t sample[SIM_SENSOR_AXES]);
+
+// Bytes currently held in the FIFO
+uint16_t sim_icm42688_fifo_level(void);
+
+void sim_bmi160_attach(void);
+
+// Same as sim_bmi160_attach(), with the model on the SPI bus
+void sim_bmi160_attach_spi(void);
+
+void sim_bmi160_tick(const int16_t sample[SIM_SENSOR_AXES]);
+
+uint16_t sim_bmi160_fifo_level(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_SENSOR_H */
@@ -0,0 +1,427 @@
+/*******************************************************************************
+  Offline Evaluation Main Source File
+
+  File Name:
+    sml_eval.c
+
+  Summary:
+    Evaluates the firmware pipeline over a labelled set of recordings while
+    sweeping a grid of post processing and sampling parameters
+
+  Description:
+    Each recording is replayed through the sensor ring buffer, segmented with
+    the given hop, classified through sml_recognition_run_segment() and post
+    processed by the majority vote, for every combination of:
+      -V  number of votes (1 to VOTING_MAX_VOTES)
+      -H  segment hop in samples (1 to the segment length)
+      -D  ODR decimation factor (every D'th sample is kept)
+      -G  energy gate threshold in LSB of peak to peak (0 = off, the default)
+      -S  segments the adaptive cadence may skip between model runs once the
+          vote is stable (0 = off, the default)
+    Reports the confusion matrix of the voted class against the label, the
+    time to first detection of the labelled class per class and the throughput
+    for each grid point. With a gate threshold it also reports the share of
+    segments gated and how many of them come from recordings not labelled
+    SML_GATE_CLASS; calibrate SML_GATE_THRESHOLD as the highest threshold
+    that keeps the accuracy of the ungated model. With a cadence it reports
+    the share of segments skipped; the detection latency shows what the
+    skips cost for SML_CADENCE_MAX_LATENCY_MS.
+
+    The (grid point, recording) jobs are spread over -j worker processes
+    (default: one per CPU). The firmware modules and the knowledge pack keep
+    their state in globals, so each worker is a forked process holding its own
+    pipeline instance rather than a thread.
+
+    usage: sml_eval [-j workers] [-V votes,...] [-H hops,...] [-D factors,...]
+                    [-G thresholds,...] [-S skips,...] [-L segment length]
+                    manifest
+    The manifest lists one recording per line as "<class id> <csv path>";
+    blank lines and lines starting with '#' are ignored.
+ *******************************************************************************/
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "ringbuffer.h"
+#include "sensor.h"
+#include "app_config.h"
+#include "kb.h"
+#include "sml_output.h"
+#include "sml_recognition_run.h"
+#include "voting.h"
+
+#define EVAL_MAX_PARAMS         16
+#define EVAL_MAX_SEGMENT_LEN    512
+
+#if !SML_GATE || !SML_CADENCE
+#error "Build with SML_GATE=1 and SML_CADENCE=1 (see the Makefile)"
+#endif
+
+typedef struct {
+    uint8_t votes;
+    uint16_t hop;
+    uint8_t decimation;
+    uint16_t gate;
+    uint8_t skip;
+} eval_params_t;
+
+typedef struct {
+    int label;
+    char path[256];
+} eval_recording_t;
+
+typedef struct {
+    int status;
+    uint32_t predicted[NUM_CLASSES];    // voted class per classification
+    int64_t detection;                  // samples until the label was first voted, -1 if never
+    uint32_t segments;
+    uint32_t gated;                     // segments reported by the energy gate
+    uint32_t skipped;                   // segments skipped by the adaptive cadence
+    uint64_t samples;
+    uint64_t ns;
+} eval_result_t;
+
+typedef struct {
+    volatile uint32_t next_job;
+    eval_result_t results[];
+} eval_shared_t;
+
+static eval_params_t *grid = NULL;
+static size_t ngrid = 0;
+static eval_recording_t *recordings = NULL;
+static size_t nrecordings = 0;
+static uint16_t seglen = 0;
+
+static struct sensor_device_t sensor;
+static snsr_data_t _snsr_buffer_data[SNSR_BUF_LEN][SNSR_NUM_AXES];
+static ringbuffer_t snsr_buffer;
+static snsr_data_t segment[SNSR_NUM_AXES * EVAL_MAX_SEGMENT_LEN];
+
+static uint64_t timer_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+size_t UART_Write(uint8_t *ptr, const size_t nbytes) {
+    (void) ptr;
+    return nbytes;
+}
+
+size_t UART_Read(uint8_t *ptr, const size_t nbytes) {
+    (void) ptr;
+    (void) nbytes;
+    return 0;
+}
+
+static int Parse_List(const char *arg, unsigned *values, unsigned lo, unsigned hi) {
+    int n = 0;
+    const char *p = arg;
+    while (*p && n < EVAL_MAX_PARAMS) {
+        char *end;
+        unsigned long v = strtoul(p, &end, 10);
+        if (end == p || v < lo || v > hi)
+            return -1;
+        values[n++] = (unsigned) v;
+        p = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0')
+            return -1;
+    }
+    return n;
+}
+
+static int Load_Manifest(const char *path) {
+    char line[300];
+    size_t maxrecordings = 0;
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL)
+        return -1;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        eval_recording_t rec;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+        if (sscanf(line, "%d %255s", &rec.label, rec.path) != 2 || rec.label < 0 || rec.label >= NUM_CLASSES) {
+            fprintf(stderr, "ERROR: %s: bad manifest line '%s'\n", path, line);
+            fclose(fp);
+            return -1;
+        }
+        if (nrecordings == maxrecordings) {
+            maxrecordings = maxrecordings ? 2 * maxrecordings : 64;
+            recordings = realloc(recordings, maxrecordings * sizeof(recordings[0]));
+            if (recordings == NULL) {
+                fclose(fp);
+                return -1;
+            }
+        }
+        recordings[nrecordings++] = rec;
+    }
+    fclose(fp);
+    return 0;
+}
+
+// Replay one recording with one parameter set; runs in a worker process
+static void Run_Job(eval_params_t const *params, eval_recording_t const *rec, eval_result_t *result) {
+    uint16_t fill = 0;
+    uint64_t t0 = timer_ns();
+
+    memset(result, 0, sizeof(*result));
+    result->detection = -1;
+
+    memset(&sensor, 0, sizeof(sensor));
+    sensor.device.path = rec->path;
+    if (sensor_init(&sensor) != SNSR_STATUS_OK || sensor_set_config(&sensor) != SNSR_STATUS_OK) {
+        result->status = sensor.status;
+        csv_sensor_close(&sensor);
+        return;
+    }
+    ringbuffer_reset(&snsr_buffer);
+    sml_recognition_reset();
+    voting_set_votes(params->votes);
+    sml_recognition_set_gate(params->gate);
+    uint32_t gated0, classified, skipped0, fallbacks;
+    sml_recognition_gate_stats(&gated0, &classified);
+    sml_recognition_cadence_stats(&skipped0, &fallbacks);
+    uint8_t stable = 0;
+
+    while (1) {
+        /* Acquire the next sample at the decimated rate */
+        ringbuffer_size_t cnt;
+        snsr_data_t *wrptr = ringbuffer_get_write_buffer(&snsr_buffer, &cnt);
+        snsr_dataframe_t skip;
+        int status = sensor_read(&sensor, wrptr);
+        for (uint8_t d=1; d < params->decimation && status == SNSR_STATUS_OK; d++)
+            status = sensor_read(&sensor, skip);
+        if (status == CSV_SENSOR_E_EOF)
+            break;
+        else if (status != SNSR_STATUS_OK) {
+            result->status = status;
+            break;
+        }
+        ringbuffer_advance_write_index(&snsr_buffer, 1);
+        result->samples++;
+
+        /* Drain into the per axis segment store */
+        snsr_dataframe_t const *rdptr = ringbuffer_get_read_buffer(&snsr_buffer, &cnt);
+        for (ringbuffer_size_t n=0; n < cnt; n++, rdptr++) {
+            for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+                segment[i * seglen + fill] = (*rdptr)[i];
+            if (++fill < seglen)
+                continue;
+
+            int ret = sml_recognition_run_segment(segment, seglen, SNSR_NUM_AXES);
+            result->segments++;
+            if (ret >= 0 && ret < NUM_CLASSES) {
+                /* Cadence from the vote stability, as in main.c */
+                if (voting_update(ret) >= 0 || voting_get_class() < 0)
+                    stable = 0;
+                else if (stable < SML_CADENCE_STABLE)
+                    stable++;
+                sml_recognition_set_cadence((stable >= SML_CADENCE_STABLE) ? params->skip : 0);
+            }
+            int cls = voting_get_class();
+            result->predicted[cls]++;
+            if (cls == rec->label && result->detection < 0)
+                result->detection = result->samples;
+
+            /* Keep the overlap with the next segment */
+            fill = seglen - params->hop;
+            for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+                memmove(&segment[i * seglen], &segment[i * seglen + params->hop], fill * sizeof(snsr_data_t));
+        }
+        ringbuffer_advance_read_index(&snsr_buffer, cnt);
+    }
+    csv_sensor_close(&sensor);
+    result->ns = timer_ns() - t0;
+    sml_recognition_gate_stats(&result->gated, &classified);
+    result->gated -= gated0;
+    sml_recognition_cadence_stats(&result->skipped, &fallbacks);
+    result->skipped -= skipped0;
+}
+
+static void Worker(eval_shared_t *shared) {
+    uint32_t njobs = ngrid * nrecordings;
+    while (1) {
+        uint32_t job = __atomic_fetch_add(&shared->next_job, 1, __ATOMIC_RELAXED);
+        if (job >= njobs)
+            break;
+        Run_Job(&grid[job / nrecordings], &recordings[job % nrecordings], &shared->results[job]);
+    }
+}
+
+static void Report(eval_params_t const *params, eval_result_t const *results) {
+    uint32_t confusion[NUM_CLASSES][NUM_CLASSES] = {{0}};
+    uint32_t nfiles[NUM_CLASSES] = {0}, ndetected[NUM_CLASSES] = {0};
+    double latency[NUM_CLASSES] = {0};
+    uint64_t correct = 0, total = 0, samples = 0, ns = 0;
+    uint64_t segments = 0, gated = 0, gated_other = 0, skipped = 0;
+    double rate = (double) SNSR_SAMPLE_RATE / params->decimation;
+
+    for (size_t r=0; r < nrecordings; r++) {
+        int label = recordings[r].label;
+        if (results[r].status != SNSR_STATUS_OK)
+            fprintf(stderr, "WARNING: %s: sensor status %d\n", recordings[r].path, results[r].status);
+        for (unsigned c=0; c < NUM_CLASSES; c++) {
+            confusion[label][c] += results[r].predicted[c];
+            total += results[r].predicted[c];
+        }
+        correct += results[r].predicted[label];
+        nfiles[label]++;
+        if (results[r].detection >= 0) {
+            ndetected[label]++;
+            latency[label] += results[r].detection / rate;
+        }
+        samples += results[r].samples;
+        ns += results[r].ns;
+        segments += results[r].segments;
+        gated += results[r].gated;
+        if (label != SML_GATE_CLASS)
+            gated_other += results[r].gated;
+        skipped += results[r].skipped;
+    }
+
+    printf("\nvotes=%u hop=%u decimation=%u gate=%u skip=%u: accuracy %.1f%% (%llu/%llu), %.0f samples/s per worker\n",
+        params->votes, params->hop, params->decimation, params->gate, params->skip, total ? 100.0 * correct / total : 0.0,
+        (unsigned long long) correct, (unsigned long long) total, ns ? 1e9 * samples / ns : 0.0);
+    if (params->gate)
+        printf("  gated %llu of %llu segments (%.1f%%), %llu of them not labelled %d\n",
+            (unsigned long long) gated, (unsigned long long) segments, segments ? 100.0 * gated / segments : 0.0,
+            (unsigned long long) gated_other, SML_GATE_CLASS);
+    if (params->skip)
+        printf("  skipped %llu of %llu segments (%.1f%%)\n",
+            (unsigned long long) skipped, (unsigned long long) segments, segments ? 100.0 * skipped / segments : 0.0);
+    printf("  label\\voted");
+    for (unsigned c=0; c < NUM_CLASSES; c++)
+        printf(" %6u", c);
+    printf("   detected  latency(s)\n");
+    for (unsigned l=0; l < NUM_CLASSES; l++) {
+        if (nfiles[l] == 0)
+            continue;
+        printf("  %11u", l);
+        for (unsigned c=0; c < NUM_CLASSES; c++)
+            printf(" %6u", (unsigned) confusion[l][c]);
+        printf("   %4u/%-4u", (unsigned) ndetected[l], (unsigned) nfiles[l]);
+        if (ndetected[l])
+            printf("  %10.2f", latency[l] / ndetected[l]);
+        printf("\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned votes[EVAL_MAX_PARAMS] = { NUM_VOTES }, hops[EVAL_MAX_PARAMS] = { 0 }, decims[EVAL_MAX_PARAMS] = { 1 };
+    unsigned gates[EVAL_MAX_PARAMS] = { 0 }, skips[EVAL_MAX_PARAMS] = { 0 };
+    int nvotes = 1, nhops = 1, ndecims = 1, ngates = 1, nskips = 1;
+    long nworkers = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *hoparg = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:V:H:D:G:S:L:")) != -1) {
+        switch (opt) {
+        case 'j':
+            nworkers = strtol(optarg, NULL, 10);
+            break;
+        case 'V':
+            nvotes = Parse_List(optarg, votes, 1, VOTING_MAX_VOTES);
+            break;
+        case 'H':
+            hoparg = optarg;
+            break;
+        case 'D':
+            ndecims = Parse_List(optarg, decims, 1, 255);
+            break;
+        case 'G':
+            ngates = Parse_List(optarg, gates, 0, UINT16_MAX);
+            break;
+        case 'S':
+            nskips = Parse_List(optarg, skips, 0, UINT8_MAX);
+            break;
+        case 'L':
+            seglen = (uint16_t) strtoul(optarg, NULL, 10);
+            break;
+        default:
+            nvotes = -1;
+            break;
+        }
+    }
+    if (seglen == 0)
+        seglen = (kb_get_segment_length(0) > 0) ? kb_get_segment_length(0) : SML_SEGMENT_LEN;
+    hops[0] = seglen;
+    if (hoparg != NULL)
+        nhops = Parse_List(hoparg, hops, 1, seglen);
+    if (nvotes <= 0 || nhops <= 0 || ndecims <= 0 || ngates <= 0 || nskips <= 0 || nworkers < 1 || seglen > EVAL_MAX_SEGMENT_LEN || optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-j workers] [-V votes,...] [-H hops,...] [-D factors,...] [-G thresholds,...] [-S skips,...] [-L segment length] manifest\n", argv[0]);
+        fprintf(stderr, "  votes 1-%d, hops 1-segment length, segment length up to %d\n", VOTING_MAX_VOTES, EVAL_MAX_SEGMENT_LEN);
+        return EXIT_FAILURE;
+    }
+    if (Load_Manifest(argv[optind]) || nrecordings == 0) {
+        fprintf(stderr, "ERROR: no recordings loaded from %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    /* Build the parameter grid */
+    grid = calloc(nvotes * nhops * ndecims * ngates * nskips, sizeof(grid[0]));
+    for (int v=0; v < nvotes; v++)
+        for (int h=0; h < nhops; h++)
+            for (int d=0; d < ndecims; d++)
+                for (int g=0; g < ngates; g++)
+                    for (int k=0; k < nskips; k++)
+                        grid[ngrid++] = (eval_params_t) { (uint8_t) votes[v], (uint16_t) hops[h], (uint8_t) decims[d],
+                                                          (uint16_t) gates[g], (uint8_t) skips[k] };
+
+    size_t njobs = ngrid * nrecordings;
+    size_t shmsize = sizeof(eval_shared_t) + njobs * sizeof(eval_result_t);
+    eval_shared_t *shared = mmap(NULL, shmsize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        fprintf(stderr, "ERROR: mmap: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    if ((size_t) nworkers > njobs)
+        nworkers = njobs;
+
+    if (ringbuffer_init(&snsr_buffer, _snsr_buffer_data, sizeof(_snsr_buffer_data) / sizeof(_snsr_buffer_data[0]), sizeof(_snsr_buffer_data[0]))) {
+        fprintf(stderr, "ERROR: sensor buffer init failed\n");
+        return EXIT_FAILURE;
+    }
+    kb_model_init();
+    sml_output_init(NULL);
+
+    printf("%zu recordings x %zu parameter sets, segment length %u, %ld workers\n", nrecordings, ngrid, seglen, nworkers);
+    fflush(stdout);
+
+    uint64_t t0 = timer_ns();
+    for (long w=0; w < nworkers; w++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            Worker(shared);
+            _exit(EXIT_SUCCESS);
+        }
+        else if (pid < 0) {
+            fprintf(stderr, "ERROR: fork: %s\n", strerror(errno));
+            return EXIT_FAILURE;
+        }
+    }
+    int failed = 0, wstatus;
+    while (wait(&wstatus) > 0)
+        failed |= !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != EXIT_SUCCESS;
+    uint64_t wall = timer_ns() - t0;
+
+    uint64_t samples = 0;
+    for (size_t g=0; g < ngrid; g++) {
+        Report(&grid[g], &shared->results[g * nrecordings]);
+        for (size_t r=0; r < nrecordings; r++)
+            samples += shared->results[g * nrecordings + r].samples;
+    }
+    printf("\n%zu jobs in %.2fs on %ld workers, %.0f samples/s overall\n", njobs, wall / 1e9, nworkers, 1e9 * samples / wall);
+
+    munmap(shared, shmsize);
+    free(grid);
+    free(recordings);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
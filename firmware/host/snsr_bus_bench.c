@@ -0,0 +1,364 @@
+/*******************************************************************************
+  Sensor Bus Benchmark Main Source File
+
+  File Name:
+    snsr_bus_bench.c
+
+  Summary:
+    Runs the sensor wrapper and vendor driver against a register level model
+    of the IMU and reports the bus cost of each driver operation
+
+  Description:
+    Built once per sensor type and bus (bus_bench_bmi160, bus_bench_bmi160_spi,
+    bus_bench_icm42688) from
+    the same app_config/ wrapper and vendor driver sources as the firmware,
+    with the MCC bus functions provided by bus_sim.c. Measures:
+      - init          sensor_init()
+      - config        sensor_set_config()
+      - read          sensor_read(), once per sample
+      - event read    sensor_read_events(), once per sample
+      - wom enter     sensor_set_wom(true), switching to wake on motion
+      - wom exit      sensor_set_wom(false), back to the sampling config
+      - fifo config   enabling the FIFO with a watermark of -f samples
+      - fifo drain    reading -f samples from the FIFO in one drain
+    and checks that the samples the driver returns match the ones fed to
+    the model. Time is simulated (see bus_sim.h); "elapsed" is the time the
+    driver spends in delays, "bus" the estimated time on the wire. The
+    highest ODR the bus time of a read or of a FIFO sample allows is printed
+    below the table. Built
+    with SNSR_BUS_STATS enabled, the firmware bus counters are printed last.
+
+    usage: bus_bench_<sensor> [-n samples] [-f fifo_samples]
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sensor.h"
+#include "app_config.h"
+#include "bus_sim.h"
+#include "sim_sensor.h"
+#include "snsr_bus_stats.h"
+
+#if SNSR_TYPE_BMI160 && SNSR_BMI160_SPI
+#define BUS_NAME            "SPI"
+#define BUS_HZ              BUS_SIM_SPI_HZ
+#define BUS_EVENTS          "CS"
+#define sim_attach          sim_bmi160_attach_spi
+#define sim_tick            sim_bmi160_tick
+#define sim_fifo_level      sim_bmi160_fifo_level
+#elif SNSR_TYPE_BMI160
+#define BUS_NAME            "I2C"
+#define BUS_HZ              BUS_SIM_I2C_HZ
+#define BUS_EVENTS          "start/stop"
+#define sim_attach          sim_bmi160_attach
+#define sim_tick            sim_bmi160_tick
+#define sim_fifo_level      sim_bmi160_fifo_level
+#elif SNSR_TYPE_ICM42688
+#define BUS_NAME            "SPI"
+#define BUS_HZ              BUS_SIM_SPI_HZ
+#define BUS_EVENTS          "CS"
+#define sim_attach          sim_icm42688_attach
+#define sim_tick            sim_icm42688_tick
+#define sim_fifo_level      sim_icm42688_fifo_level
+#else
+#error "bus benchmark needs SNSR_TYPE_BMI160 or SNSR_TYPE_ICM42688"
+#endif
+
+#define BENCH_MAX_FIFO_SAMPLES  128
+// Sensor start up time allowed before filling the FIFO
+#define BENCH_STARTUP_US        100000UL
+
+struct bench_result {
+    const char *name;
+    uint32_t calls;
+    struct bus_sim_stats stats;
+    uint64_t elapsed_us;
+};
+
+static struct sensor_device_t sensor;
+static uint32_t sample_index = 0;
+static int16_t history[BENCH_MAX_FIFO_SAMPLES][SIM_SENSOR_AXES];
+static unsigned mismatches = 0;
+
+static struct bench_result results[10];
+static unsigned nresults = 0;
+static struct bench_result *current = NULL;
+static uint64_t start_us;
+
+static void Bench_Begin(const char *name) {
+    current = &results[nresults++];
+    memset(current, 0, sizeof(*current));
+    current->name = name;
+}
+
+static void Bench_Start(void) {
+    bus_sim_reset_stats();
+    start_us = read_timer_us();
+}
+
+static void Bench_Stop(void) {
+    struct bus_sim_stats s;
+    bus_sim_get_stats(&s);
+    current->calls++;
+    current->elapsed_us += read_timer_us() - start_us;
+    current->stats.transactions += s.transactions;
+    current->stats.tx_bytes += s.tx_bytes;
+    current->stats.rx_bytes += s.rx_bytes;
+    current->stats.cs_events += s.cs_events;
+    current->stats.starts += s.starts;
+    current->stats.restarts += s.restarts;
+    current->stats.stops += s.stops;
+    current->stats.nacks += s.nacks;
+}
+
+// Generate the next sample, feed it to the model and advance one ODR period
+static const int16_t *Sample_Next(void) {
+    int16_t *s = history[sample_index % BENCH_MAX_FIFO_SAMPLES];
+    for (uint8_t i=0; i < SIM_SENSOR_AXES; i++)
+        s[i] = (int16_t) (sample_index * 257U + i * 4099U);
+    sample_index++;
+    sim_tick(s);
+    bus_sim_advance_us(1000000UL / SNSR_SAMPLE_RATE);
+    return s;
+}
+
+static void Sample_Check(const int16_t *expected, const int16_t *got, uint8_t mask) {
+    for (uint8_t i=0, k=0; i < SIM_SENSOR_AXES; i++) {
+        if (mask & (1U << i)) {
+            if (expected[i] != got[k++])
+                mismatches++;
+        }
+    }
+}
+
+#if SNSR_TYPE_BMI160
+static struct bmi160_fifo_frame fifo_frame;
+static uint8_t fifo_data[BENCH_MAX_FIFO_SAMPLES * 13 + 4];
+
+static int Fifo_Config(unsigned nsamples) {
+    int status;
+    sensor.device.fifo = &fifo_frame;
+    status = bmi160_set_fifo_config(BMI160_FIFO_GYRO | BMI160_FIFO_ACCEL | BMI160_FIFO_HEADER, BMI160_ENABLE, &sensor.device);
+    if (status == BMI160_OK)
+        status = bmi160_set_fifo_wm((uint8_t) ((nsamples * 13 + 3) / 4), &sensor.device);
+    return status;
+}
+
+static int Fifo_Drain(unsigned nsamples) {
+    int status;
+    fifo_frame.data = fifo_data;
+    fifo_frame.length = sizeof(fifo_data);
+    status = bmi160_get_fifo_data(&sensor.device);
+    return (status == BMI160_OK) ? (int) nsamples : status;
+}
+
+static void Fifo_Check(unsigned nsamples, uint32_t first) {
+    struct bmi160_sensor_data accel[BENCH_MAX_FIFO_SAMPLES], gyro[BENCH_MAX_FIFO_SAMPLES];
+    uint8_t naccel = BENCH_MAX_FIFO_SAMPLES, ngyro = BENCH_MAX_FIFO_SAMPLES;
+
+    bmi160_extract_accel(accel, &naccel, &sensor.device);
+    bmi160_extract_gyro(gyro, &ngyro, &sensor.device);
+    if (naccel != nsamples || ngyro != nsamples) {
+        mismatches += nsamples;
+        return;
+    }
+    for (unsigned n=0; n < nsamples; n++) {
+        const int16_t *e = history[(first + n) % BENCH_MAX_FIFO_SAMPLES];
+        int16_t got[SIM_SENSOR_AXES] = { accel[n].x, accel[n].y, accel[n].z, gyro[n].x, gyro[n].y, gyro[n].z };
+        Sample_Check(e, got, 0x3F);
+    }
+}
+#else
+/* Frames drained from the FIFO; the driver also reads the 16 byte packets into
+ * them, so they have to hold BENCH_MAX_FIFO_SAMPLES packets */
+#define BENCH_FIFO_FRAMES   ((BENCH_MAX_FIFO_SAMPLES * 16 + sizeof(snsr_dataframe_t) - 1) / sizeof(snsr_dataframe_t))
+static snsr_dataframe_t fifo_frames[BENCH_FIFO_FRAMES];
+static int nfifo_frames = 0;
+
+static int Fifo_Config(unsigned nsamples) {
+    int status = inv_icm426xx_configure_fifo(&sensor.device, INV_ICM426XX_FIFO_ENABLED);
+    status |= inv_icm426xx_configure_fifo_wm(&sensor.device, (uint16_t) nsamples);
+    return status;
+}
+
+static int Fifo_Drain(unsigned nsamples) {
+    nfifo_frames = sensor_read_fifo(&sensor, fifo_frames[0], BENCH_FIFO_FRAMES);
+    return nfifo_frames;
+}
+
+static void Fifo_Check(unsigned nsamples, uint32_t first) {
+    if (nfifo_frames != (int) nsamples) {
+        mismatches += nsamples;
+        return;
+    }
+    for (unsigned n=0; n < nsamples; n++)
+        Sample_Check(history[(first + n) % BENCH_MAX_FIFO_SAMPLES], fifo_frames[n], SNSR_AXIS_MASK);
+}
+#endif
+
+static void Result_Print(const struct bench_result *r, unsigned per) {
+    double d = (double) r->calls * per;
+    printf("%-22s %6u %8.1f %8.1f %8.1f %10.1f %8.1f %10.1f %10.1f\n", r->name, (unsigned) (r->calls * per),
+        r->stats.transactions / d, r->stats.tx_bytes / d, r->stats.rx_bytes / d,
+        (r->stats.cs_events ? r->stats.cs_events : r->stats.starts + r->stats.restarts + r->stats.stops) / d,
+        r->stats.restarts / d, bus_sim_bus_time_us(&r->stats) / d, r->elapsed_us / d);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned nsamples = 1000, nfifo = 7;
+    snsr_data_t frame[SNSR_NUM_AXES];
+    int status;
+
+    for (int i=1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            nsamples = (unsigned) atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            nfifo = (unsigned) atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-n samples] [-f fifo_samples]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (nsamples == 0 || nfifo == 0 || nfifo > BENCH_MAX_FIFO_SAMPLES) {
+        fprintf(stderr, "ERROR: need -n > 0 and 0 < -f <= %d\n", BENCH_MAX_FIFO_SAMPLES);
+        return EXIT_FAILURE;
+    }
+
+    /* Data register interface */
+    sim_attach();
+    Bench_Begin("init");
+    Bench_Start();
+    status = sensor_init(&sensor);
+    Bench_Stop();
+    if (status != SNSR_STATUS_OK) {
+        fprintf(stderr, "ERROR: sensor init result = %d\n", status);
+        return EXIT_FAILURE;
+    }
+
+    Bench_Begin("config");
+    Bench_Start();
+    status = sensor_set_config(&sensor);
+    Bench_Stop();
+    if (status != SNSR_STATUS_OK) {
+        fprintf(stderr, "ERROR: sensor config result = %d\n", status);
+        return EXIT_FAILURE;
+    }
+
+    Bench_Begin("read");
+    for (unsigned n=0; n < nsamples; n++) {
+        const int16_t *s = Sample_Next();
+        Bench_Start();
+        status = sensor_read(&sensor, frame);
+        Bench_Stop();
+        if (status != SNSR_STATUS_OK) {
+            fprintf(stderr, "ERROR: sensor read result = %d\n", status);
+            return EXIT_FAILURE;
+        }
+        Sample_Check(s, frame, SNSR_AXIS_MASK);
+    }
+
+#ifdef sensor_read_events
+    /* Added to each sample read when SNSR_EVENTS is enabled */
+    Bench_Begin("event read");
+    for (unsigned n=0; n < nsamples; n++) {
+        uint8_t events;
+        Bench_Start();
+        status = sensor_read_events(&sensor, 1, &events);
+        Bench_Stop();
+        if (status != SNSR_STATUS_OK || events != 0) {
+            fprintf(stderr, "ERROR: sensor event read result = %d, events 0x%02x\n", status, events);
+            return EXIT_FAILURE;
+        }
+    }
+#endif
+
+#ifdef sensor_set_wom
+    /* The motion engine is not modelled; only the register traffic of the
+     * switch and the reads after it are checked */
+    Bench_Begin("wom enter");
+    Bench_Start();
+    status = sensor_set_wom(&sensor, true);
+    Bench_Stop();
+    Bench_Begin("wom exit");
+    Bench_Start();
+    status |= sensor_set_wom(&sensor, false);
+    Bench_Stop();
+    if (status != SNSR_STATUS_OK) {
+        fprintf(stderr, "ERROR: sensor wake on motion result = %d\n", status);
+        return EXIT_FAILURE;
+    }
+    bus_sim_advance_us(BENCH_STARTUP_US);
+    for (unsigned n=0; n < 8; n++) {
+        const int16_t *s = Sample_Next();
+        if (sensor_read(&sensor, frame) != SNSR_STATUS_OK) {
+            fprintf(stderr, "ERROR: sensor read after wake on motion failed\n");
+            return EXIT_FAILURE;
+        }
+        Sample_Check(s, frame, SNSR_AXIS_MASK);
+    }
+#endif
+
+    /* FIFO; start again from power on, enabling the FIFO before the sensors */
+    sim_attach();
+    status = sensor_init(&sensor);
+    Bench_Begin("fifo config");
+    Bench_Start();
+    status |= Fifo_Config(nfifo);
+    Bench_Stop();
+    status |= sensor_set_config(&sensor);
+    if (status != SNSR_STATUS_OK) {
+        fprintf(stderr, "ERROR: FIFO config result = %d\n", status);
+        return EXIT_FAILURE;
+    }
+    bus_sim_advance_us(BENCH_STARTUP_US);
+
+    Bench_Begin("fifo drain");
+    for (unsigned k=0; k < nsamples / nfifo; k++) {
+        uint32_t first = sample_index;
+        for (unsigned n=0; n < nfifo; n++)
+            Sample_Next();
+        Bench_Start();
+        status = Fifo_Drain(nfifo);
+        Bench_Stop();
+        if (status != (int) nfifo || sim_fifo_level() != 0) {
+            fprintf(stderr, "ERROR: FIFO drain of %u samples returned %d with %u bytes left\n",
+                nfifo, status, (unsigned) sim_fifo_level());
+            return EXIT_FAILURE;
+        }
+        Fifo_Check(nfifo, first);
+    }
+
+    printf("bus cost for %s on %s at %lu kHz (F_CPU %lu MHz), axis mask 0x%02x, %d Hz\n",
+        SNSR_NAME, BUS_NAME, (unsigned long) (BUS_HZ / 1000), (unsigned long) (F_CPU / 1000000UL),
+        SNSR_AXIS_MASK, SNSR_SAMPLE_RATE);
+    printf("%-22s %6s %8s %8s %8s %10s %8s %10s %10s\n", "operation", "count", "trans",
+        "tx B", "rx B", BUS_EVENTS, "restart", "bus us", "elapsed us");
+    for (unsigned i=0; i < nresults; i++) {
+        Result_Print(&results[i], 1);
+        if (strcmp(results[i].name, "fifo drain") == 0) {
+            struct bench_result per = results[i];
+            per.name = "  per sample";
+            Result_Print(&per, nfifo);
+        }
+    }
+    /* Bus bound only; the CPU time of the driver and the application comes on top */
+    for (unsigned i=0; i < nresults; i++) {
+        unsigned per = (strcmp(results[i].name, "fifo drain") == 0) ? nfifo : 1;
+        double us = bus_sim_bus_time_us(&results[i].stats) / ((double) results[i].calls * per);
+        if (strcmp(results[i].name, "read") == 0 || per > 1)
+            printf("max ODR from %-9s %8.0f Hz (%.1f us per sample)\n", results[i].name, 1e6 / us, us);
+    }
+
+#if SNSR_BUS_STATS
+    /* Totals of the firmware counters over all of the operations above */
+    snsr_bus_stats_report();
+#endif
+
+    if (mismatches) {
+        fprintf(stderr, "ERROR: %u sample values differ from the model\n", mismatches);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
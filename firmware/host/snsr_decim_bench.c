@@ -0,0 +1,116 @@
+/*******************************************************************************
+  Decimator Benchmark Source File
+
+  File Name:
+    snsr_decim_bench.c
+
+  Summary:
+    Checks the response of the CIC decimator feeding the model
+    (decimator.c) and times it per full rate input sample.
+
+  Notes:
+    - Built by 'make decim' with SML_DECIMATION=$(DECIM) and the application
+      configuration; frequencies are given relative to the output (model)
+      rate, so the results hold for any SNSR_SAMPLE_RATE.
+    - Checks that DC passes unchanged on every axis, that a tone at 0.1 x the
+      output rate comes out at the amplitude given by the CIC response, and
+      reports how much a tone that folds onto it from around the output rate
+      is attenuated (dropping samples instead passes it at full amplitude).
+ *******************************************************************************/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "decimator.h"
+
+#if SML_DECIMATION < 2
+#error "Build with SML_DECIMATION of 2 or more"
+#endif
+
+// Output frames per measurement, after BENCH_SETTLE
+#define BENCH_FRAMES        200
+#define BENCH_SETTLE        8
+#define BENCH_PI            3.14159265358979
+#define BENCH_AMPLITUDE     8000.0
+
+#define BENCH_ITERS         2000UL
+#include "bench_timer.h"
+
+
+// Magnitude of the CIC response at f, relative to the output rate
+static double bench_cic_gain(double f) {
+    double x = BENCH_PI * f / SML_DECIMATION;
+    return pow(fabs(sin(BENCH_PI * f) / (SML_DECIMATION * sin(x))), SML_DECIMATION_ORDER);
+}
+
+// Run a tone at f (relative to the output rate) through the decimator and
+// return the amplitude of the output on axis 0 at the frequency it folds to,
+// once the filter settles; BENCH_FRAMES covers whole periods of it
+static double bench_tone(double f) {
+    snsr_dataframe_t in, out;
+    double fo = f - floor(f + 0.5);
+    double re = 0.0, im = 0.0;
+    long k = 0;
+
+    decimator_reset();
+    for (uint16_t m=0; m < BENCH_SETTLE + BENCH_FRAMES; ) {
+        double v = BENCH_AMPLITUDE * sin(2.0 * BENCH_PI * f * k++ / SML_DECIMATION);
+        for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+            in[i] = (snsr_data_t) lrint(v);
+        if (decimator_push(in, out) && m++ >= BENCH_SETTLE) {
+            re += out[0] * cos(2.0 * BENCH_PI * fo * m);
+            im += out[0] * sin(2.0 * BENCH_PI * fo * m);
+        }
+    }
+    return 2.0 * sqrt(re * re + im * im) / BENCH_FRAMES / BENCH_AMPLITUDE;
+}
+
+int main(void) {
+    static const snsr_data_t dc[] = { 0, 1, -1, 12345, -12345, INT16_MAX, INT16_MIN };
+    snsr_dataframe_t in, out;
+    int failed = 0;
+
+    printf("decimation %d, CIC order %d, %d axes\n", SML_DECIMATION, SML_DECIMATION_ORDER, SNSR_NUM_AXES);
+
+    /* DC on every axis, including full scale */
+    for (uint8_t d=0; d < sizeof(dc) / sizeof(dc[0]); d++) {
+        int err = 0;
+        decimator_reset();
+        for (uint16_t m=0; m < 4 * SML_DECIMATION_ORDER; ) {
+            for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+                in[i] = dc[d];
+            if (decimator_push(in, out) && m++ >= SML_DECIMATION_ORDER) {
+                for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+                    if (abs(out[i] - dc[d]) > err)
+                        err = abs(out[i] - dc[d]);
+            }
+        }
+        printf("dc %6d: error %d LSB%s\n", dc[d], err, err > 1 ? "  FAIL" : "");
+        failed |= err > 1;
+    }
+
+    /* Passband tone against the CIC response, and the tone folding onto it */
+    double pass = bench_tone(0.1);
+    double expect = bench_cic_gain(0.1);
+    int pass_fail = fabs(pass - expect) > 0.01;
+    printf("tone at 0.1 x output rate: gain %.3f, expected %.3f%s\n", pass, expect, pass_fail ? "  FAIL" : "");
+    failed |= pass_fail;
+    double alias = bench_tone(0.9);
+    printf("tone at 0.9 x output rate (folds to 0.1): gain %.3f (%.1fdB)\n", alias, 20.0 * log10(alias + 1e-9));
+
+    /* Time per full rate input sample, outputs included */
+    for (uint8_t i=0; i < SNSR_NUM_AXES; i++)
+        in[i] = (snsr_data_t) (1000 * i - 2500);
+    decimator_reset();
+    bench_time_t t0 = bench_timer_read();
+    for (unsigned long it=0; it < BENCH_ITERS; it++) {
+        for (uint16_t n=0; n < SML_DECIMATION; n++) {
+            in[0] ^= (snsr_data_t) n;
+            bench_sink += decimator_push(in, out);
+        }
+    }
+    bench_time_t t = bench_timer_read() - t0;
+    printf("decimator_push: %lu %s per %d input samples\n", (unsigned long) (t / BENCH_ITERS), BENCH_UNIT, SML_DECIMATION);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+/*******************************************************************************
+  Sensor Filter Offload Benchmark Source File
+
+  File Name:
+    snsr_filter_bench.c
+
+  Summary:
+    Checks that the model features stay the same when the anti-aliasing and
+    low pass filtering moves from the MCU to the IMU (SNSR_FILTER_HZ), and
+    times the MCU side of both.
+
+  Notes:
+    - Host build:
+        cc -O2 -o snsr_filter_bench snsr_filter_bench.c -lm
+    - Synthetic fan recordings (off, three speeds, shaking and tapping, plus
+      motor noise above the Nyquist frequency) are passed through a model of
+      the IMU filter and sampled at BENCH_RATE. The IMU filter is modelled as
+      a first order low pass at its -3dB point, run at BENCH_OVERSAMPLE times
+      the output rate.
+    - The "software" path uses the filter the dataset was recorded with
+      (BENCH_WIDE_HZ) and the kb_shim.c feature low pass; the "on-chip" path
+      uses the IMU filter at BENCH_FILTER_HZ and the lighter MCU low pass
+      (BENCH_LIGHT_SHIFT, 0 for none). The features are computed as in
+      kb_shim.c and must agree within BENCH_TOLERANCE (in feature units,
+      0-255) for the program to succeed.
+ *******************************************************************************/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef BENCH_RATE
+#define BENCH_RATE          100
+#endif
+
+// IMU filter -3dB point of the on-chip path (SNSR_FILTER_HZ)
+#ifndef BENCH_FILTER_HZ
+#define BENCH_FILTER_HZ     10
+#endif
+
+// IMU filter -3dB point of the recorded dataset (BMI160 normal mode)
+#ifndef BENCH_WIDE_HZ
+#define BENCH_WIDE_HZ       (BENCH_RATE * 2 / 5)
+#endif
+
+// Feature low pass y += (x - y) >> shift of each path
+#define BENCH_FULL_SHIFT    2
+#ifndef BENCH_LIGHT_SHIFT
+#define BENCH_LIGHT_SHIFT   0
+#endif
+
+#ifndef BENCH_TOLERANCE
+#define BENCH_TOLERANCE     8
+#endif
+
+#define BENCH_LEN           100
+#define BENCH_AXES          6
+#define BENCH_OVERSAMPLE    8
+#define BENCH_ZC_THRESHOLD  64
+#define BENCH_NFEATURES     3
+#define BENCH_PI            3.14159265358979
+
+#define BENCH_ITERS         20000UL
+#include "bench_timer.h"
+
+// Signal of one recording, in LSB at the 2g / 125dps ranges; every axis
+// gets the vibration and motor noise, at a per axis phase
+typedef struct {
+    const char *name;
+    float vib_hz;       // rotation frequency
+    float vib_lsb;
+    float shake_hz;     // hand shaking the fan
+    float shake_lsb;
+    float motor_lsb;    // motor/blade noise at BENCH_MOTOR_HZ
+    float noise_lsb;    // uniform noise
+    uint8_t taps;       // impulses per recording
+} bench_case_t;
+
+#define BENCH_MOTOR_HZ      (BENCH_RATE * 1.8f)
+
+static const bench_case_t bench_cases[] = {
+    { "off",       0.0f,    0.0f, 0.0f,    0.0f,    0.0f,  40.0f, 0 },
+    { "speed_1",   8.0f,  600.0f, 0.0f,    0.0f,  400.0f,  40.0f, 0 },
+    { "speed_2",  12.0f,  900.0f, 0.0f,    0.0f,  600.0f,  40.0f, 0 },
+    { "speed_3",  16.0f, 1200.0f, 0.0f,    0.0f,  800.0f,  40.0f, 0 },
+    { "shaking",  12.0f,  900.0f, 2.0f, 6000.0f,  600.0f,  40.0f, 0 },
+    { "tapping",  12.0f,  900.0f, 0.0f,    0.0f,  600.0f,  40.0f, 4 },
+};
+
+// Offsets of each axis: gravity on AZ, gyro bias
+static const float bench_dc[BENCH_AXES] = { 200.0f, -300.0f, 16384.0f, 20.0f, -15.0f, 5.0f };
+
+static int16_t window[2][BENCH_LEN][BENCH_AXES];
+
+static uint16_t lfsr;
+
+static float bench_noise(void) {
+    lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+    return (float) lfsr / 32768.0f - 1.0f;
+}
+
+// Record one segment through an IMU filter with a -3dB point of cutoff_hz
+static void bench_record(const bench_case_t *c, float cutoff_hz, int16_t out[BENCH_LEN][BENCH_AXES]) {
+    const float fs = (float) BENCH_RATE * BENCH_OVERSAMPLE;
+    const float a = 1.0f - expf(-2.0f * (float) BENCH_PI * cutoff_hz / fs);
+    const long warmup = BENCH_OVERSAMPLE * BENCH_LEN;
+    float y[BENCH_AXES];
+
+    lfsr = 0xACE1u;
+    for (uint8_t i=0; i < BENCH_AXES; i++)
+        y[i] = bench_dc[i];
+
+    for (long k=-warmup; k < (long) BENCH_LEN * BENCH_OVERSAMPLE; k++) {
+        float t = (float) k / fs;
+        float tap = 0.0f;
+        if (c->taps && k >= 0 && (k % (BENCH_LEN * BENCH_OVERSAMPLE / c->taps)) < BENCH_OVERSAMPLE / 2)
+            tap = 8000.0f;
+        for (uint8_t i=0; i < BENCH_AXES; i++) {
+            float ph = (float) i;
+            float x = bench_dc[i] + tap
+                + c->vib_lsb * sinf(2.0f * (float) BENCH_PI * c->vib_hz * t + ph)
+                + c->shake_lsb * sinf(2.0f * (float) BENCH_PI * c->shake_hz * t + ph)
+                + c->motor_lsb * sinf(2.0f * (float) BENCH_PI * BENCH_MOTOR_HZ * t + 2.0f * ph)
+                + c->noise_lsb * bench_noise();
+            y[i] += a * (x - y[i]);
+            if (k >= 0 && (k % BENCH_OVERSAMPLE) == 0)
+                out[k / BENCH_OVERSAMPLE][i] = (int16_t) lrintf(y[i]);
+        }
+    }
+}
+
+static uint8_t bench_scale(int32_t value, int32_t full_scale) {
+    int32_t v = (value * 255) / full_scale;
+    return (uint8_t) (v > 255 ? 255 : (v < 0 ? 0 : v));
+}
+
+// GlobalPeaktoPeakofLowFrequency as in kb_shim.c, with the low pass shift
+// as a parameter; the part of the feature pipeline the MCU runs per sample
+static int32_t bench_peak_to_peak(int16_t const x[BENCH_LEN][BENCH_AXES], uint8_t shift) {
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    for (uint8_t c=0; c < BENCH_AXES; c++) {
+        int32_t y = x[0][c];
+        for (uint16_t n=1; n < BENCH_LEN; n++) {
+            if (shift)
+                y += (x[n][c] - y) >> shift;
+            else
+                y = x[n][c];
+            if (y < lo)
+                lo = y;
+            if (y > hi)
+                hi = y;
+        }
+    }
+    return hi - lo;
+}
+
+static void bench_features(int16_t const x[BENCH_LEN][BENCH_AXES], uint8_t shift, uint8_t fv[BENCH_NFEATURES]) {
+    int32_t mean = 0;
+    int pos = 0, neg = 0, state = 0;
+
+    for (uint16_t n=0; n < BENCH_LEN; n++)
+        mean += x[n][0];
+    mean /= BENCH_LEN;
+    for (uint16_t n=0; n < BENCH_LEN; n++) {
+        int32_t v = x[n][0] - mean;
+        if (v > BENCH_ZC_THRESHOLD && state <= 0) {
+            pos += (state < 0);
+            state = 1;
+        }
+        else if (v < -BENCH_ZC_THRESHOLD && state >= 0) {
+            neg += (state > 0);
+            state = -1;
+        }
+    }
+
+    fv[0] = bench_scale(pos, BENCH_LEN / 2);
+    fv[1] = bench_scale(neg, BENCH_LEN / 2);
+    fv[2] = bench_scale(bench_peak_to_peak(x, shift), 32768);
+}
+
+static bench_time_t bench_time(int16_t const x[BENCH_LEN][BENCH_AXES], uint8_t shift) {
+    bench_time_t t0 = bench_timer_read();
+    for (unsigned long it=0; it < BENCH_ITERS; it++)
+        bench_sink += bench_peak_to_peak(x, shift);
+    return bench_timer_read() - t0;
+}
+
+int main(void) {
+    int worst = 0;
+
+    printf("%dHz, IMU filter %dHz vs %dHz, MCU low pass shift %d vs %d, tolerance %d\n",
+        BENCH_RATE, BENCH_FILTER_HZ, BENCH_WIDE_HZ, BENCH_LIGHT_SHIFT, BENCH_FULL_SHIFT, BENCH_TOLERANCE);
+    printf("%-10s %-14s %-14s %s\n", "case", "software", "on-chip", "diff");
+    for (uint8_t k=0; k < sizeof(bench_cases) / sizeof(bench_cases[0]); k++) {
+        uint8_t fv_sw[BENCH_NFEATURES], fv_hw[BENCH_NFEATURES];
+        int diff = 0;
+
+        bench_record(&bench_cases[k], BENCH_WIDE_HZ, window[0]);
+        bench_record(&bench_cases[k], BENCH_FILTER_HZ, window[1]);
+        bench_features(window[0], BENCH_FULL_SHIFT, fv_sw);
+        bench_features(window[1], BENCH_LIGHT_SHIFT, fv_hw);
+        for (uint8_t i=0; i < BENCH_NFEATURES; i++) {
+            int d = abs((int) fv_sw[i] - (int) fv_hw[i]);
+            if (d > diff)
+                diff = d;
+        }
+        if (diff > worst)
+            worst = diff;
+        printf("%-10s %3u %3u %3u    %3u %3u %3u    %3d%s\n", bench_cases[k].name,
+            fv_sw[0], fv_sw[1], fv_sw[2], fv_hw[0], fv_hw[1], fv_hw[2], diff,
+            diff > BENCH_TOLERANCE ? "  FAIL" : "");
+    }
+
+    bench_time_t t_sw = bench_time(window[0], BENCH_FULL_SHIFT);
+    bench_time_t t_hw = bench_time(window[1], BENCH_LIGHT_SHIFT);
+    printf("low frequency peak to peak, %s per %d sample segment (%d axes): software %lu  on-chip %lu\n",
+        BENCH_UNIT, BENCH_LEN, BENCH_AXES, (unsigned long) (t_sw / BENCH_ITERS), (unsigned long) (t_hw / BENCH_ITERS));
+
+    return worst > BENCH_TOLERANCE ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+  Sensor Buffer Layout Benchmark Source File
+
+  File Name:
+    snsr_layout_bench.c
+
+  Summary:
+    Times typical per-axis feature kernels over the sensor buffer stored as
+    array of structures (SNSR_BUF_LAYOUT_AOS) and as structure of arrays
+    (SNSR_BUF_LAYOUT_SOA).
+
+  Notes:
+    - Host build:
+        cc -O2 -o snsr_layout_bench snsr_layout_bench.c
+    - Define BENCH_AXES and BENCH_LEN to match SNSR_NUM_AXES and SNSR_BUF_LEN
+      of the configuration of interest.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef BENCH_AXES
+#define BENCH_AXES  6
+#endif
+
+#ifndef BENCH_LEN
+#define BENCH_LEN   32
+#endif
+
+#define BENCH_ITERS         200000UL
+#include "bench_timer.h"
+
+static int16_t aos[BENCH_LEN][BENCH_AXES];
+static int16_t soa[BENCH_AXES][BENCH_LEN];
+
+// Kernels working on one axis; 'stride' is the distance in samples between
+// consecutive samples of the axis (BENCH_AXES for AOS, 1 for SOA)
+static int16_t zero_crossings(int16_t const *x, uint8_t stride) {
+    int16_t count = 0;
+    int16_t prev = *x;
+    for (uint16_t n=1; n < BENCH_LEN; n++) {
+        x += stride;
+        if ((prev ^ *x) < 0)
+            count++;
+        prev = *x;
+    }
+    return count;
+}
+
+static int16_t peak_to_peak(int16_t const *x, uint8_t stride) {
+    int16_t lo = *x, hi = *x;
+    for (uint16_t n=1; n < BENCH_LEN; n++) {
+        x += stride;
+        if (*x < lo)
+            lo = *x;
+        if (*x > hi)
+            hi = *x;
+    }
+    return hi - lo;
+}
+
+static int16_t lowpass(int16_t const *x, uint8_t stride) {
+    int16_t y = *x;
+    for (uint16_t n=1; n < BENCH_LEN; n++) {
+        x += stride;
+        y += (*x - y) >> 3;
+    }
+    return y;
+}
+
+typedef int16_t (*kernel_t)(int16_t const *, uint8_t);
+
+static bench_time_t bench_run(kernel_t kernel, int16_t const *base, uint8_t axis_step, uint8_t stride) {
+    bench_time_t t0 = bench_timer_read();
+    for (unsigned long it=0; it < BENCH_ITERS; it++) {
+        for (uint8_t i=0; i < BENCH_AXES; i++)
+            bench_sink += kernel(base + i * axis_step, stride);
+    }
+    return bench_timer_read() - t0;
+}
+
+int main(void) {
+    static const struct {
+        const char *name;
+        kernel_t kernel;
+    } kernels[] = {
+        { "zero_crossings", zero_crossings },
+        { "peak_to_peak", peak_to_peak },
+        { "lowpass", lowpass },
+    };
+
+    /* Deterministic test signal; the same samples in both layouts */
+    uint16_t lfsr = 0xACE1u;
+    for (uint16_t n=0; n < BENCH_LEN; n++) {
+        for (uint8_t i=0; i < BENCH_AXES; i++) {
+            lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+            aos[n][i] = soa[i][n] = (int16_t) lfsr;
+        }
+    }
+
+    printf("%d axes x %d samples, time per pass over all axes in %s\n", BENCH_AXES, BENCH_LEN, BENCH_UNIT);
+    for (uint8_t k=0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        bench_time_t t_aos = bench_run(kernels[k].kernel, &aos[0][0], 1, BENCH_AXES);
+        bench_time_t t_soa = bench_run(kernels[k].kernel, &soa[0][0], BENCH_LEN, 1);
+        printf("%-16s aos %8lu  soa %8lu\n", kernels[k].name,
+            (unsigned long) (t_aos / BENCH_ITERS), (unsigned long) (t_soa / BENCH_ITERS));
+    }
+
+    return 0;
+}
@@ -52,6 +52,44 @@
 // Dump data to uart in form suitable for SensiMLs Data Capture Lab (simple stream format)
 #define DATA_STREAMER_FORMAT_SMLSS      3
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Enumeration of IMU axes
+// *****************************************************************************
+// *****************************************************************************
+// Axis flags for SNSR_AXIS_MASK; bit position gives the order within a frame
+#define SNSR_AXIS_AX                    (1U << 0)
+#define SNSR_AXIS_AY                    (1U << 1)
+#define SNSR_AXIS_AZ                    (1U << 2)
+#define SNSR_AXIS_GX                    (1U << 3)
+#define SNSR_AXIS_GY                    (1U << 4)
+#define SNSR_AXIS_GZ                    (1U << 5)
+#define SNSR_AXIS_ACCEL                 (SNSR_AXIS_AX | SNSR_AXIS_AY | SNSR_AXIS_AZ)
+#define SNSR_AXIS_GYRO                  (SNSR_AXIS_GX | SNSR_AXIS_GY | SNSR_AXIS_GZ)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Enumeration of available knowledge pack ingestion modes
+// *****************************************************************************
+// *****************************************************************************
+// Feed the knowledge pack one sample frame at a time through kb_run_model()
+#define SML_INGEST_MODE_STREAM          0
+
+// Capture whole segments in place and hand them to the knowledge pack through
+// kb_add_segment()/kb_run_segment()
+#define SML_INGEST_MODE_SEGMENT         1
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Enumeration of available sensor buffer layouts
+// *****************************************************************************
+// *****************************************************************************
+// Store samples frame by frame (array of structures), i.e. [SNSR_BUF_LEN][SNSR_NUM_AXES]
+#define SNSR_BUF_LAYOUT_AOS             0
+
+// Store samples axis by axis (structure of arrays), i.e. [SNSR_NUM_AXES][SNSR_BUF_LEN]
+#define SNSR_BUF_LAYOUT_SOA             1
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: User configurable application level parameters
@@ -82,12 +120,176 @@
 // For BMI160 use one of: 125, 250, 500, 1000, 2000
 #define SNSR_GYRO_RANGE         125
 
-// Define which axes from the IMU to use
-#define SNSR_USE_ACCEL          true
-#define SNSR_USE_GYRO           true
+// IMU digital low pass (anti-aliasing) filter -3dB point in Hz
+//  - 0 keeps the settings the dataset was recorded with: BMI160 normal mode
+//    (about 0.4 x SNSR_SAMPLE_RATE) and ICM42688 max(400Hz, SNSR_SAMPLE_RATE)/4
+//  - otherwise the widest IMU filter with a -3dB point at or below
+//    SNSR_FILTER_HZ is derived from SNSR_SAMPLE_RATE, or the narrowest one;
+//    at 100Hz both IMUs reach 10Hz, which removes the motor noise above the
+//    Nyquist frequency and stands in for the low pass of the low frequency
+//    features, so the knowledge pack can drop its own
+//  - the knowledge pack must be trained on data captured with the same
+//    setting; host/snsr_filter_bench.c compares the features of both paths
+#ifndef SNSR_FILTER_HZ
+#define SNSR_FILTER_HZ          0
+#endif
+
+// BMI160 serial interface
+//  - 0: I2C on TWI0 at 100kHz
+//  - 1: 4-wire SPI on SPI0 with the MIKRO1 CS pin, as used by the ICM42688;
+//    set the IMU 2 click COMM SEL jumpers to SPI
+#ifndef SNSR_BMI160_SPI
+#define SNSR_BMI160_SPI         0
+#endif
+
+// Define which axes from the IMU to use as a combination of SNSR_AXIS_* flags
+//  - should list the channels used by the knowledge pack; may be provided at
+//    the project level (e.g. from the knowledge pack's sensor usage)
+//  - only the axes listed are read from the IMU, buffered and fed to the model;
+//    a sensor with no axes in use is powered down
+#ifndef SNSR_AXIS_MASK
+#define SNSR_AXIS_MASK          (SNSR_AXIS_ACCEL | SNSR_AXIS_GYRO)
+#endif
 
 // Size of sensor buffer in samples (must be power of 2)
+//  - the ICM42688 configuration builds the driver without its 2kB FIFO mirror
+//    (ICM426XX_FIFO_MIRRORING_SIZE=0) and spends part of it on a deeper buffer
+#ifndef SNSR_BUF_LEN
+#if SNSR_TYPE_ICM42688
+#define SNSR_BUF_LEN            128
+#else
 #define SNSR_BUF_LEN            32
+#endif
+#endif
+
+// Sensor buffer memory layout selection
+//  - SNSR_BUF_LAYOUT_SOA keeps one contiguous column per axis for per-axis
+//    processing; frames are gathered from the columns where a consumer needs them
+//  - segments used with SML_INGEST_MODE_SEGMENT are always stored per axis
+#ifndef SNSR_BUF_LAYOUT
+#define SNSR_BUF_LAYOUT         SNSR_BUF_LAYOUT_AOS
+#endif
+
+// Sensor FIFO draining (ICM42688 only)
+//  - with SNSR_FIFO_READ the IMU queues its samples in its FIFO and interrupts
+//    once more than SNSR_FIFO_WATERMARK are waiting, in place of a data ready
+//    interrupt per sample; the interrupt drains the FIFO in burst reads
+//    straight into the free region of the sensor buffer
+//  - needs SML_INGEST_MODE_STREAM and SNSR_BUF_LAYOUT_AOS
+#ifndef SNSR_FIFO_READ
+#define SNSR_FIFO_READ          0
+#endif
+#ifndef SNSR_FIFO_WATERMARK
+#define SNSR_FIFO_WATERMARK     8
+#endif
+
+// Knowledge pack ingestion mode selection
+#ifndef SML_INGEST_MODE
+#define SML_INGEST_MODE         SML_INGEST_MODE_STREAM
+#endif
+
+// Segment length in samples used with SML_INGEST_MODE_SEGMENT
+//  - must match the window size of the knowledge pack's segmenter; the pack
+//    carries no constant for it and kb_get_segment_length() only gives the
+//    size of the segment in progress, so it is not checked
+//  - also the segment length tracked by the energy gate (SML_GATE)
+#ifndef SML_SEGMENT_LEN
+#define SML_SEGMENT_LEN         100
+#endif
+
+// Hop between the start of consecutive segments in samples used with SML_INGEST_MODE_SEGMENT
+//  - set equal to SML_SEGMENT_LEN for back to back segments
+//  - set lower than SML_SEGMENT_LEN for overlapping (sliding) segments;
+//    a classification is then produced every SML_SEGMENT_HOP samples. The
+//    overlap is copied into the next segment and every feature is computed
+//    again over the whole segment, so the model CPU time grows with the
+//    overlap factor SML_SEGMENT_LEN / SML_SEGMENT_HOP
+//  - stream ingestion follows the knowledge pack's own segmenter and rejects
+//    any other value
+#ifndef SML_SEGMENT_HOP
+#define SML_SEGMENT_HOP         SML_SEGMENT_LEN
+#endif
+
+// Number of segments held in the sensor buffer with SML_INGEST_MODE_SEGMENT
+// (must be power of 2); the segments replace the SNSR_BUF_LEN sample buffer,
+// which takes more RAM: 2400 bytes for 2 segments of 100 6-axis frames
+// against 384 bytes for 32 frames, with the library's own segment buffer kept
+#ifndef SNSR_SEGMENT_BUF_LEN
+#define SNSR_SEGMENT_BUF_LEN    2
+#endif
+
+// Decimating front end (SML_INGEST_MODE_STREAM only)
+//  - with SML_DECIMATION above 1 the IMU runs at SNSR_SAMPLE_RATE and the main
+//    loop passes its samples through a CIC decimator of order
+//    SML_DECIMATION_ORDER (1 to 3); the model is fed at SML_SAMPLE_RATE, e.g.
+//    800Hz / 8 (BMI160 on SPI) or 1000Hz / 10 (ICM42688) for the 100Hz model;
+//    see decimator.h
+//  - SML_DECIMATION must divide SNSR_SAMPLE_RATE and be at most 16; raise
+//    SNSR_BUF_LEN to hold the samples taken during the longest model run
+//  - the full rate samples are handed to a consumer ahead of the decimator;
+//    with APP_CAPTURE it keeps the last APP_CAPTURE_LEN of them, printed with
+//    sampling stopped when APP_CAPTURE_CMD is received over the UART
+#ifndef SML_DECIMATION
+#define SML_DECIMATION          1
+#endif
+#ifndef SML_DECIMATION_ORDER
+#define SML_DECIMATION_ORDER    2
+#endif
+#ifndef APP_CAPTURE
+#define APP_CAPTURE             0
+#endif
+#define APP_CAPTURE_LEN         128
+#define APP_CAPTURE_CMD         'c'
+
+// Energy gate
+//  - with SML_GATE the recognition run keeps the peak to peak of every axis
+//    over the segment in progress; a segment where no axis spans
+//    SML_GATE_THRESHOLD LSB or more is reported as SML_GATE_CLASS without
+//    running feature generation and the classifier
+//  - the segment restarts with every classification of the model, so the
+//    gate follows the knowledge pack's own segment boundaries; with a
+//    segmenter that classifies before SML_SEGMENT_LEN frames, the gate never
+//    sees a full segment and the model runs as without it
+//  - the threshold sits above the sensor noise floor at the 2g / 125dps
+//    ranges; calibrate it on the dataset with sml_eval -G and keep the value
+//    where the accuracy stays that of the ungated model. sml_eval runs the
+//    host stand-in for the knowledge pack, so check the accuracy again on
+//    the board with the real library
+//  - the number of gated and classified segments is added to the profile
+//    report
+#ifndef SML_GATE
+#define SML_GATE                0
+#endif
+#ifndef SML_GATE_THRESHOLD
+#define SML_GATE_THRESHOLD      256
+#endif
+#define SML_GATE_CLASS          1       // Fan Off
+
+// Adaptive inference cadence
+//  - with SML_CADENCE, once the vote has held its class for
+//    SML_CADENCE_STABLE classifications and the features of the last two
+//    model runs differ by at most SML_CADENCE_FV_MARGIN (sum over the
+//    features, 0-255 each), the model skips up to SML_CADENCE_SKIP segments
+//    between runs; a skipped segment gives no classification and the vote
+//    holds
+//  - the peak to peak of every axis is tracked over each segment; a segment
+//    where one moved away from the last model run by more than
+//    SML_CADENCE_DRIFT_PCT percent plus SML_CADENCE_DRIFT_LSB runs the model
+//    at once, and every segment does so until the features settle again
+//  - SML_CADENCE_MAX_LATENCY_MS bounds the time from a change the peak to
+//    peak does not show to the model run that sees it; SML_CADENCE_SKIP
+//    follows from it. It excludes the vote: the classification reported
+//    changes only after the vote takes the new class, which comes on top
+#ifndef SML_CADENCE
+#define SML_CADENCE             0
+#endif
+#ifndef SML_CADENCE_MAX_LATENCY_MS
+#define SML_CADENCE_MAX_LATENCY_MS  4000
+#endif
+#define SML_CADENCE_STABLE      5
+#define SML_CADENCE_FV_MARGIN   8
+#define SML_CADENCE_DRIFT_PCT   25
+#define SML_CADENCE_DRIFT_LSB   64
 
 // Type used to store and stream sensor samples
 #define SNSR_DATA_TYPE          int16_t
@@ -105,6 +307,88 @@
 #define SNSR_SAMPLES_PER_PACKET 1
 #endif
 
+// Run time profiling of the application
+//  - the time spent in the sensor interrupt, the model and the result output,
+//    the CPU idle fraction and the highest sustainable sample rate are printed
+//    every APP_PROFILE_REPORT_MS milliseconds
+#ifndef APP_PROFILE
+#define APP_PROFILE             0
+#endif
+#define APP_PROFILE_REPORT_MS   5000
+
+// Sensor bus statistics
+//  - count the SPI/I2C calls, bytes, transactions, busy wait time and errors
+//    of the sensor driver; sending SNSR_BUS_STATS_CMD over the UART prints
+//    the counters and resets them
+#ifndef SNSR_BUS_STATS
+#define SNSR_BUS_STATS          0
+#endif
+#define SNSR_BUS_STATS_CMD      'b'
+
+// Sleep while idle
+//  - the CPU sleeps in IDLE mode when the sensor buffer is empty and during
+//    timed delays; see idle.h
+//  - off by default until measured on the board
+#ifndef APP_IDLE_SLEEP
+#define APP_IDLE_SLEEP          0
+#endif
+
+// Wake on motion
+//  - after APP_WOM_OFF_COUNT consecutive classifications of APP_WOM_OFF_CLASS
+//    the pipeline stops and the IMU is put in low power, accel only wake on
+//    motion mode; acceleration changing by more than SNSR_WOM_THRESHOLD_MG
+//    between two samples restarts it
+//  - needs a sensor with a motion engine (BMI160 or ICM42688)
+#ifndef APP_WOM
+#define APP_WOM                 0
+#endif
+#define APP_WOM_OFF_CLASS       1       // Fan Off
+#define APP_WOM_OFF_COUNT       10
+#define SNSR_WOM_THRESHOLD_MG   40
+
+// Hardware events
+//  - SNSR_EVENTS enables the tap and high-g (BMI160) or tap and significant
+//    motion (ICM42688) engines of the IMU, routed to its INT2 output; the
+//    event status is held by the IMU and read by the sensor interrupt once
+//    it has read SNSR_EVENT_POLL_MS milliseconds of samples since the last
+//    time; with SNSR_FIFO_READ that is at most once per FIFO drain
+//  - a tap or shake event is reported at once as a provisional
+//    APP_EVENT_TAP_CLASS or APP_EVENT_SHAKE_CLASS classification, which the
+//    next APP_EVENT_CONFIRM_COUNT classifications confirm or clear
+//  - the BMI160 high-g engine compares the acceleration on each axis with
+//    SNSR_EVENT_SHAKE_MG, so it has to clear gravity; the ICM42688 significant
+//    motion engine compares each sample with the previous one against it, at
+//    most 996mg (checked at build time)
+//  - ICM42688 tap detection needs a sample rate of 200Hz to 1kHz; below that
+//    the build warns and only shake events are reported
+#ifndef SNSR_EVENTS
+#define SNSR_EVENTS             0
+#endif
+#define SNSR_EVENT_TAP_MG       625
+#define SNSR_EVENT_POLL_MS      50
+#ifndef SNSR_EVENT_SHAKE_MG
+#if SNSR_TYPE_ICM42688
+#define SNSR_EVENT_SHAKE_MG     500
+#else
+#define SNSR_EVENT_SHAKE_MG     1500
+#endif
+#endif
+#define APP_EVENT_TAP_CLASS     6       // Tapping
+#define APP_EVENT_SHAKE_CLASS   2       // Shaking
+#define APP_EVENT_CONFIRM_COUNT 3
+
+// Run time clock scaling
+//  - the CPU runs at F_CPU while sampling and idle, and at
+//    APP_CLOCK_BOOST_F_CPU while the model processes buffered samples that
+//    complete a segment; see clock_scaling.h
+//  - the energy saving has not been measured on the board
+#ifndef APP_CLOCK_BOOST
+#define APP_CLOCK_BOOST         0
+#endif
+#ifndef APP_CLOCK_BOOST_F_CPU
+#define APP_CLOCK_BOOST_F_CPU   24000000
+#endif
+
 // LED tick rate periods in ms
 #define TICK_RATE_FAST          100
 #define TICK_RATE_SLOW          500
@@ -114,7 +398,14 @@
 // Section: Defines derived from user config parameters
 // *****************************************************************************
 // *****************************************************************************
-#define SNSR_NUM_AXES   (3*SNSR_USE_ACCEL + 3*SNSR_USE_GYRO)
+#define SNSR_USE_ACCEL  ((SNSR_AXIS_MASK & SNSR_AXIS_ACCEL) != 0)
+#define SNSR_USE_GYRO   ((SNSR_AXIS_MASK & SNSR_AXIS_GYRO) != 0)
+#define SNSR_NUM_AXES   (((SNSR_AXIS_MASK >> 0) & 1) + ((SNSR_AXIS_MASK >> 1) & 1) + ((SNSR_AXIS_MASK >> 2) & 1) \
+                       + ((SNSR_AXIS_MASK >> 3) & 1) + ((SNSR_AXIS_MASK >> 4) & 1) + ((SNSR_AXIS_MASK >> 5) & 1))
+
+#if ((SNSR_AXIS_MASK & (SNSR_AXIS_ACCEL | SNSR_AXIS_GYRO)) == 0) || ((SNSR_AXIS_MASK & ~(SNSR_AXIS_ACCEL | SNSR_AXIS_GYRO)) != 0)
+#error "SNSR_AXIS_MASK must be a non-empty combination of SNSR_AXIS_* flags"
+#endif
 
 /* Define whether multiple sensors types are being used */
 #if (SNSR_USE_ACCEL && SNSR_USE_GYRO)
@@ -128,6 +419,74 @@
 #error "SNSR_SAMPLES_PER_PACKET must be a factor of SNSR_BUF_LEN"
 #endif
 
+#if (SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT) && (DATA_STREAMER_FORMAT != DATA_STREAMER_FORMAT_NONE)
+#error "SML_INGEST_MODE_SEGMENT stores samples per axis and cannot be combined with data streaming"
+#endif
+
+#if (SML_SEGMENT_HOP == 0) || (SML_SEGMENT_HOP > SML_SEGMENT_LEN)
+#error "SML_SEGMENT_HOP must be between 1 and SML_SEGMENT_LEN"
+#endif
+
+#if (SML_INGEST_MODE == SML_INGEST_MODE_STREAM) && (SML_SEGMENT_HOP != SML_SEGMENT_LEN)
+#error "SML_SEGMENT_HOP only applies to SML_INGEST_MODE_SEGMENT"
+#endif
+
+#if (SML_SEGMENT_HOP < SML_SEGMENT_LEN) && (SNSR_SEGMENT_BUF_LEN < 2)
+#error "Overlapping segments require SNSR_SEGMENT_BUF_LEN of at least 2"
+#endif
+
+#if SNSR_FIFO_READ && !SNSR_TYPE_ICM42688
+#error "SNSR_FIFO_READ is only supported by the ICM42688"
+#endif
+
+#if SNSR_FIFO_READ && ((SML_INGEST_MODE != SML_INGEST_MODE_STREAM) || (SNSR_BUF_LAYOUT != SNSR_BUF_LAYOUT_AOS))
+#error "SNSR_FIFO_READ requires SML_INGEST_MODE_STREAM and SNSR_BUF_LAYOUT_AOS"
+#endif
+
+#if SNSR_FIFO_READ && ((SNSR_FIFO_WATERMARK < 1) || (SNSR_FIFO_WATERMARK > SNSR_BUF_LEN / 2))
+#error "SNSR_FIFO_WATERMARK must be between 1 and SNSR_BUF_LEN / 2"
+#endif
+
+// The 16 byte FIFO packets are read into the sample frames and decoded in
+// place; a drain needs room for at least one packet
+#define SNSR_FIFO_PACKET_SIZE   16
+#define SNSR_FIFO_PACKET_FRAMES ((SNSR_FIFO_PACKET_SIZE + sizeof(snsr_dataframe_t) - 1) / sizeof(snsr_dataframe_t))
+
+// Rate of the samples fed to the model
+#define SML_SAMPLE_RATE (SNSR_SAMPLE_RATE / SML_DECIMATION)
+
+#if (SML_DECIMATION < 1) || (SML_DECIMATION > 16) || (SNSR_SAMPLE_RATE % SML_DECIMATION != 0)
+#error "SML_DECIMATION must be 1 to 16 and divide SNSR_SAMPLE_RATE"
+#endif
+
+#if (SML_DECIMATION > 1) && (SML_INGEST_MODE != SML_INGEST_MODE_STREAM)
+#error "SML_DECIMATION requires SML_INGEST_MODE_STREAM"
+#endif
+
+#if (SML_DECIMATION_ORDER < 1) || (SML_DECIMATION_ORDER > 3)
+#error "SML_DECIMATION_ORDER must be 1 to 3"
+#endif
+
+// Samples between segments and the segments the adaptive cadence may skip
+#if SML_INGEST_MODE == SML_INGEST_MODE_SEGMENT
+#define SML_CADENCE_PERIOD      SML_SEGMENT_HOP
+#else
+#define SML_CADENCE_PERIOD      SML_SEGMENT_LEN
+#endif
+#define SML_CADENCE_SKIP        (SML_CADENCE_MAX_LATENCY_MS * 1UL * SML_SAMPLE_RATE / (1000UL * SML_CADENCE_PERIOD) - 1)
+
+#if SML_CADENCE && ((SML_CADENCE_SKIP < 1) || (SML_CADENCE_SKIP > 255))
+#error "SML_CADENCE_MAX_LATENCY_MS must span 2 to 256 segments"
+#endif
+
+// Samples read between reads of the event status
+#define SNSR_EVENT_POLL         ((SNSR_SAMPLE_RATE * SNSR_EVENT_POLL_MS / 1000UL) > 1 ? \
+                                 (SNSR_SAMPLE_RATE * SNSR_EVENT_POLL_MS / 1000UL) : 1)
+
+#if APP_CAPTURE && (SML_DECIMATION < 2)
+#error "APP_CAPTURE records the full rate samples of the decimating front end; set SML_DECIMATION"
+#endif
+
 // Provide the functions needed by sensor module
 #define snsr_read_timer_us read_timer_us
 #define snsr_read_timer_ms read_timer_ms
@@ -140,6 +499,10 @@
 #define SNSR_NAME "bmi160"
 #elif SNSR_TYPE_ICM42688
 #define SNSR_NAME "icm42688"
+#elif SNSR_TYPE_CSV
+#define SNSR_NAME "csv"
+#elif SNSR_TYPE_REPLAY
+#define SNSR_NAME "replay"
 #endif
 
 // *****************************************************************************
@@ -182,11 +545,20 @@ size_t __attribute__(( unused )) UART_Read(uint8_t *ptr, const size_t nbytes);
 #define SYS_Tasks           __nullop__
 
 // Sensor external interrupt
+#if SNSR_TYPE_REPLAY
+#define MIKRO_INT_CallbackRegister  replay_sensor_set_handler
+#else
 #define MIKRO_INT_CallbackRegister  PORTD_MIKRO1_INT_SetInterruptHandler
+#endif
 
 // uS Timer
 #define TC_TimerStart               __nullop__
-#define TC_TimerGet_us              TCA0_ReadTimer
+#if APP_CLOCK_BOOST
+uint16_t clock_scaling_timer_us(void);
+#define TC_TimerGet_us()            clock_scaling_timer_us()
+#else
+#define TC_TimerGet_us()            (TCA0_ReadTimer() / TCA0_TICKS_PER_US)
+#endif
 #define TC_TimerCallbackRegister    TCA0_SetOVFIsrCallback
 
 #ifdef	__cplusplus
@@ -196,6 +568,8 @@ extern "C" {
 typedef SNSR_DATA_TYPE snsr_data_t;
 typedef SNSR_DATA_TYPE snsr_dataframe_t[SNSR_NUM_AXES];
 typedef SNSR_DATA_TYPE snsr_datapacket_t[SNSR_NUM_AXES*SNSR_SAMPLES_PER_PACKET];
+typedef SNSR_DATA_TYPE snsr_segment_t[SNSR_NUM_AXES][SML_SEGMENT_LEN];
+typedef SNSR_DATA_TYPE snsr_axisbuffer_t[SNSR_NUM_AXES][SNSR_BUF_LEN];
 
 #ifdef	__cplusplus
 }
@@ -48,6 +48,26 @@ uint32_t sml_output_results(uint16_t model, uint16_t classification)
     return 0;
 }
 
+uint32_t sml_output_event(uint16_t model, uint16_t classification, const char *state)
+{
+    snprintf(serial_out_buf, sizeof(serial_out_buf),
+             "{\"ModelNumber\":%d,\"Classification\":%d,\"Event\":\"%s\"}\n",
+             (int) model, (int) classification, state);
+
+    UART_Write((uint8_t *) serial_out_buf, strlen(serial_out_buf));
+    return 0;
+}
+
+uint32_t sml_output_gated(uint16_t model, uint16_t classification)
+{
+    snprintf(serial_out_buf, sizeof(serial_out_buf),
+             "{\"ModelNumber\":%d,\"Classification\":%d,\"Gated\":true}\n",
+             (int) model, (int) classification);
+
+    UART_Write((uint8_t *) serial_out_buf, strlen(serial_out_buf));
+    return 0;
+}
+
 uint32_t sml_output_init(void *p_module)
 {
     //unused for now
@@ -7,6 +7,14 @@ uint32_t sml_output_init(void *p_module);
 
 uint32_t sml_output_results(uint16_t model, uint16_t classification);
 
+/* Report a classification made outside the model, e.g. from a sensor event;
+ * state tells whether it is provisional, confirmed or cleared */
+uint32_t sml_output_event(uint16_t model, uint16_t classification, const char *state);
+
+/* Report a classification made by the energy gate, which has no feature
+ * vector */
+uint32_t sml_output_gated(uint16_t model, uint16_t classification);
+
 #ifdef	__cplusplus
 extern "C" {
 #endif /* __cplusplus */
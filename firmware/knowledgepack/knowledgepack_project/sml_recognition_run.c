@@ -1,7 +1,10 @@
+#include <stdbool.h>
+#include <string.h>
 #include "app_config.h"
 #include "kb.h"
 #include "sml_output.h"
 #include "sml_recognition_run.h"
+#include "profile.h"
 #ifdef SML_USE_TEST_DATA
 #include "testdata.h"
 int td_index = 0;
@@ -9,17 +12,309 @@ int td_index = 0;
 
 #define KB_MODEL_j1_rank_0_INDEX 0
 
+/* Streamed frames are counted into segments for the gate, the cadence and
+ * the clock boost */
+#define SML_SEGMENT_COUNT   (SML_GATE || SML_CADENCE || APP_CLOCK_BOOST)
+
+#if SML_SEGMENT_COUNT
+/* Frames of the segment in progress; it restarts with the model window after
+ * each classification, so it follows the knowledge pack's own segmenter
+ * rather than assuming one that restarts every SML_SEGMENT_LEN frames */
+static uint16_t seg_fill = 0;
+
+/* Outcome of a complete segment ahead of the model, or the class the gate
+ * reports for it */
+#define SEGMENT_RUN     -1
+#define SEGMENT_SKIP    -2
+#endif
+
+#if SML_GATE || SML_CADENCE
+/* Range of every axis over the segment in progress */
+static snsr_data_t seg_min[SNSR_NUM_AXES], seg_max[SNSR_NUM_AXES];
+
+static uint16_t sml_segment_range(int i)
+{
+    return (uint16_t) (seg_max[i] - seg_min[i]);
+}
+#endif
+
+#if SML_GATE
+static uint16_t gate_threshold = SML_GATE_THRESHOLD;
+static uint32_t gate_gated = 0, gate_classified = 0;
+
+static bool sml_gate_quiet(void)
+{
+    for (int i=0; i < SNSR_NUM_AXES; i++)
+        if (sml_segment_range(i) >= gate_threshold)
+            return false;
+    return true;
+}
+
+void sml_recognition_set_gate(uint16_t threshold)
+{
+    gate_threshold = threshold;
+}
+
+void sml_recognition_gate_stats(uint32_t *gated, uint32_t *classified)
+{
+    *gated = gate_gated;
+    *classified = gate_classified;
+}
+#endif
+
+#if SML_CADENCE
+/* Adaptive cadence: segments the caller lets the model skip, and the axis
+ * ranges and features of the last model run the next segments are held to */
+static uint8_t cadence_allowed = 0, cadence_skipped = 0;
+static bool cadence_settled = false;
+static uint16_t cadence_range[SNSR_NUM_AXES];
+static uint8_t cadence_fv[MAX_VECTOR_SIZE];
+static uint32_t cadence_skips = 0, cadence_fallbacks = 0;
+
+/* Skip the segment while the features have settled and no axis range moved
+ * away from the last model run; a range that moved runs the model at once */
+static bool sml_cadence_skip(void)
+{
+    if (!cadence_settled || cadence_skipped >= cadence_allowed)
+        return false;
+    for (int i=0; i < SNSR_NUM_AXES; i++) {
+        uint16_t r = sml_segment_range(i), ref = cadence_range[i];
+        uint16_t d = (r > ref) ? r - ref : ref - r;
+        if ((uint32_t) d * 100U > (uint32_t) ref * SML_CADENCE_DRIFT_PCT + 100UL * SML_CADENCE_DRIFT_LSB) {
+            cadence_settled = false;
+            cadence_fallbacks++;
+            return false;
+        }
+    }
+    cadence_skipped++;
+    cadence_skips++;
+    return true;
+}
+
+/* After a model run; kb_get_classification_result_info() would give the
+ * distance to the pattern, but the PME result it fills has no type in the
+ * knowledge pack headers, so how far the feature vector moved since the last
+ * run stands in for it. SML_CADENCE_MAX_LATENCY_MS covers the skipped
+ * segments only; the vote adds its own latency on top */
+static void sml_cadence_update(void)
+{
+    uint8_t fv[MAX_VECTOR_SIZE], len;
+    uint16_t d = 0;
+
+    kb_get_feature_vector(KB_MODEL_j1_rank_0_INDEX, fv, &len);
+    for (uint8_t j=0; j < len; j++)
+        d += (fv[j] > cadence_fv[j]) ? fv[j] - cadence_fv[j] : cadence_fv[j] - fv[j];
+    memcpy(cadence_fv, fv, len);
+    for (int i=0; i < SNSR_NUM_AXES; i++)
+        cadence_range[i] = sml_segment_range(i);
+    cadence_settled = (d <= SML_CADENCE_FV_MARGIN);
+    cadence_skipped = 0;
+}
+
+void sml_recognition_set_cadence(uint8_t skip)
+{
+    cadence_allowed = skip;
+}
+
+void sml_recognition_cadence_stats(uint32_t *skipped, uint32_t *fallbacks)
+{
+    *skipped = cadence_skips;
+    *fallbacks = cadence_fallbacks;
+}
+#endif
+
+#if SML_GATE || SML_CADENCE
+/* Decide on a complete segment before the model computes its features */
+static int sml_segment_end(void)
+{
+#if SML_GATE
+    if (sml_gate_quiet()) {
+        gate_gated++;
+        PROFILE_START(PROFILE_OUTPUT);
+        sml_output_gated(KB_MODEL_j1_rank_0_INDEX, SML_GATE_CLASS);
+        PROFILE_END(PROFILE_OUTPUT);
+        return SML_GATE_CLASS;
+    }
+#endif
+#if SML_CADENCE
+    if (sml_cadence_skip())
+        return SEGMENT_SKIP;
+#endif
+    return SEGMENT_RUN;
+}
+#endif
+
+#if SML_SEGMENT_COUNT
+/* Add a streamed frame ahead of the model; a segment that does not run the
+ * model is dropped from its window */
+static int sml_segment_add(snsr_data_t const *data)
+{
+#if SML_GATE || SML_CADENCE
+    for (int i=0; i < SNSR_NUM_AXES; i++) {
+        if (seg_fill == 0 || data[i] < seg_min[i])
+            seg_min[i] = data[i];
+        if (seg_fill == 0 || data[i] > seg_max[i])
+            seg_max[i] = data[i];
+    }
+#else
+    (void) data;
+#endif
+    if (++seg_fill < SML_SEGMENT_LEN)
+        return SEGMENT_RUN;
+    seg_fill = 0;
+
+#if SML_GATE || SML_CADENCE
+    int ret = sml_segment_end();
+    if (ret != SEGMENT_RUN) {
+        kb_flush_model_buffer(KB_MODEL_j1_rank_0_INDEX);
+        kb_reset_model(KB_MODEL_j1_rank_0_INDEX);
+    }
+    return ret;
+#else
+    return SEGMENT_RUN;
+#endif
+}
+#endif
+
+#if APP_CLOCK_BOOST
+bool sml_recognition_segment_due(int nframes)
+{
+    return seg_fill + nframes >= SML_SEGMENT_LEN;
+}
+#endif
+
+#if SML_GATE || SML_CADENCE
+
+/* A segment handed over whole takes one pass instead */
+static int sml_segment_scan(snsr_data_t const *segment, int seglen)
+{
+    for (int i=0; i < SNSR_NUM_AXES; i++) {
+        snsr_data_t const *x = &segment[i * seglen];
+        seg_min[i] = seg_max[i] = x[0];
+        for (int n=1; n < seglen; n++) {
+            if (x[n] < seg_min[i])
+                seg_min[i] = x[n];
+            if (x[n] > seg_max[i])
+                seg_max[i] = x[n];
+        }
+    }
+    return sml_segment_end();
+}
+#endif
+
+#if SML_SEGMENT_COUNT
+/* The model classified the segment and restarts its window */
+static void sml_segment_classified(void)
+{
+    seg_fill = 0;
+#if SML_GATE
+    gate_classified++;
+#endif
+#if SML_CADENCE
+    sml_cadence_update();
+#endif
+}
+#endif
+
 int sml_recognition_run(snsr_data_t *data, int num_sensors)
 {
     int ret;
+#if SML_SEGMENT_COUNT
+    ret = sml_segment_add(data);
+    if (ret != SEGMENT_RUN)
+        return (ret == SEGMENT_SKIP) ? -1 : ret;
+#endif
 //    uint32_t runtime = read_timer_us();
     ret = kb_run_model((SENSOR_DATA_T *)data, num_sensors, KB_MODEL_j1_rank_0_INDEX);
 //    runtime = read_timer_us() - runtime;
     if (ret >= 0){
+#if SML_SEGMENT_COUNT
+        sml_segment_classified();
+#endif
+        PROFILE_START(PROFILE_OUTPUT);
         sml_output_results(KB_MODEL_j1_rank_0_INDEX, ret);
+        PROFILE_END(PROFILE_OUTPUT);
         kb_reset_model(0);
 //        printf("Classification completed in %lums\n", runtime);
     };
 
     return ret;
 }
+
+int sml_recognition_run_batch(snsr_data_t *data, int nframes, int num_sensors, int *nconsumed)
+{
+    int ret = -1;
+    int i = 0;
+    /* Stream contiguous frames until the model completes a segment so the
+     * caller gets to act on each classification */
+    while (i < nframes) {
+#if SML_SEGMENT_COUNT
+        ret = sml_segment_add(data);
+        if (ret != SEGMENT_RUN) {
+            data += num_sensors;
+            i++;
+            if (ret == SEGMENT_SKIP) {
+                ret = -1;
+                continue;
+            }
+            break;
+        }
+#endif
+        ret = kb_run_model((SENSOR_DATA_T *)data, num_sensors, KB_MODEL_j1_rank_0_INDEX);
+        data += num_sensors;
+        i++;
+        if (ret >= 0){
+#if SML_SEGMENT_COUNT
+            sml_segment_classified();
+#endif
+            PROFILE_START(PROFILE_OUTPUT);
+            sml_output_results(KB_MODEL_j1_rank_0_INDEX, ret);
+            PROFILE_END(PROFILE_OUTPUT);
+            kb_reset_model(0);
+            break;
+        }
+    }
+    *nconsumed = i;
+
+    return ret;
+}
+
+int sml_recognition_run_segment(snsr_data_t *segment, int seglen, int num_sensors)
+{
+    int ret;
+#if SML_GATE || SML_CADENCE
+    ret = sml_segment_scan(segment, seglen);
+    if (ret != SEGMENT_RUN)
+        return (ret == SEGMENT_SKIP) ? -1 : ret;
+#endif
+    /* Point the model at the captured segment in place; the data is stored per
+     * axis, i.e. num_sensors contiguous columns of seglen samples each */
+    kb_add_segment((uint16_t *)segment, seglen, num_sensors, KB_MODEL_j1_rank_0_INDEX);
+    ret = kb_run_segment(KB_MODEL_j1_rank_0_INDEX);
+    if (ret >= 0){
+#if SML_SEGMENT_COUNT
+        sml_segment_classified();
+#endif
+        PROFILE_START(PROFILE_OUTPUT);
+        sml_output_results(KB_MODEL_j1_rank_0_INDEX, ret);
+        PROFILE_END(PROFILE_OUTPUT);
+    };
+    /* Each segment is handed over whole, so always advance the model */
+    kb_reset_model(0);
+
+    return ret;
+}
+
+void sml_recognition_reset(void)
+{
+    kb_flush_model_buffer(KB_MODEL_j1_rank_0_INDEX);
+    kb_reset_model(KB_MODEL_j1_rank_0_INDEX);
+#if SML_SEGMENT_COUNT
+    seg_fill = 0;
+#endif
+#if SML_CADENCE
+    cadence_allowed = 0;
+    cadence_skipped = 0;
+    cadence_settled = false;
+#endif
+}
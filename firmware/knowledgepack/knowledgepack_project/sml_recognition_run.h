@@ -1,6 +1,7 @@
 #ifndef SML_RECOGNITION_RUN_H
 #define	SML_RECOGNITION_RUN_H
 
+#include <stdbool.h>
 #include "app_config.h"
 
 #ifdef	__cplusplus
@@ -9,6 +10,42 @@ extern "C" {
 
 int sml_recognition_run(snsr_data_t *data, int num_sensors);
 
+/* Run nframes contiguous frames through the model, stopping early once a
+ * classification is made; nconsumed returns the number of frames used */
+int sml_recognition_run_batch(snsr_data_t *data, int nframes, int num_sensors, int *nconsumed);
+
+int sml_recognition_run_segment(snsr_data_t *segment, int seglen, int num_sensors);
+
+/* Drop the samples of the window in progress, e.g. after a gap in the data */
+void sml_recognition_reset(void);
+
+#if APP_CLOCK_BOOST
+/* True when nframes more streamed frames complete the segment in progress,
+ * i.e. the model is about to classify */
+bool sml_recognition_segment_due(int nframes);
+#endif
+
+#if SML_GATE
+/* Energy gate threshold in LSB of peak to peak (SML_GATE_THRESHOLD at
+ * start-up, 0 disables the gate) */
+void sml_recognition_set_gate(uint16_t threshold);
+
+/* Segments reported by the energy gate and segments classified by the model
+ * since start-up */
+void sml_recognition_gate_stats(uint32_t *gated, uint32_t *classified);
+#endif
+
+#if SML_CADENCE
+/* Segments the model may skip between runs while the classification is
+ * stable (up to SML_CADENCE_SKIP, 0 to run on every segment); reset to 0 by
+ * sml_recognition_reset() */
+void sml_recognition_set_cadence(uint8_t skip);
+
+/* Segments skipped, and skips cancelled by a change in the axis ranges,
+ * since start-up */
+void sml_recognition_cadence_stats(uint32_t *skipped, uint32_t *fallbacks);
+#endif
+
 #ifdef	__cplusplus
 }
 #endif /* __cplusplus */